@@ -0,0 +1,37 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "bench_common.hpp"
+
+#include "dataforge/base_xx/ascii85.hpp"
+#include "dataforge/base_xx/base16.hpp"
+#include "dataforge/base_xx/base32.hpp"
+#include "dataforge/base_xx/base58.hpp"
+#include "dataforge/base_xx/base64.hpp"
+#include "dataforge/base_xx/z85.hpp"
+
+namespace dataforge::bench {
+
+void register_base_xx_benchmarks(registry& r)
+{
+    r.add("base_xx", "base16-encode", int8 | base16l);
+    r.add("base_xx", "base16-decode", base16l | int8, encoded_by(int8 | base16l));
+    r.add("base_xx", "base32-encode", int8 | base32);
+    r.add("base_xx", "base32-decode", base32 | int8, encoded_by(int8 | base32));
+    r.add("base_xx", "base64-encode", int8 | base64);
+    r.add("base_xx", "base64-decode", base64 | int8, encoded_by(int8 | base64));
+    r.add("base_xx", "ascii85-encode", int8 | ascii85);
+    r.add("base_xx", "ascii85-decode", ascii85 | int8, encoded_by(int8 | ascii85));
+    r.add("base_xx", "z85-encode", int8 | z85);
+    r.add("base_xx", "z85-decode", z85 | int8, encoded_by(int8 | z85));
+
+    // base58 is a big-number conversion, quadratic in the message size
+    r.add("base_xx", "base58-encode", int8 | base58(base58_type::BITCOIN)).max_size = 4096;
+    r.add("base_xx", "base58-decode", base58(base58_type::BITCOIN) | int8, encoded_by(int8 | base58(base58_type::BITCOIN))).max_size = 4096;
+}
+
+}
@@ -0,0 +1,27 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "bench_common.hpp"
+
+#include "dataforge/checksum/adler32.hpp"
+#include "dataforge/checksum/bsd.hpp"
+#include "dataforge/checksum/crc.hpp"
+
+namespace dataforge::bench {
+
+void register_checksum_benchmarks(registry& r)
+{
+    r.add("checksum", "adler32", int8 | adler32);
+    r.add("checksum", "bsd", int8 | bsd_checksum);
+    r.add("checksum", "crc8", int8 | crc(crc8_type::DEFAULT));
+    r.add("checksum", "crc16", int8 | crc(crc16_type::DEFAULT));
+    r.add("checksum", "crc32", int8 | crc(crc32_type::DEFAULT));
+    r.add("checksum", "crc32c", int8 | crc(crc32_type::C));
+    r.add("checksum", "crc64-xz", int8 | crc(crc64_type::XZ));
+}
+
+}
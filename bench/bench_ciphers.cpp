@@ -0,0 +1,54 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "bench_common.hpp"
+
+#include "dataforge/ciphers/aes.hpp"
+#include "dataforge/ciphers/belt.hpp"
+#include "dataforge/ciphers/blowfish.hpp"
+#include "dataforge/ciphers/des.hpp"
+#include "dataforge/ciphers/kuznyechik.hpp"
+#include "dataforge/ciphers/magma.hpp"
+#include "dataforge/ciphers/rc4.hpp"
+#include "dataforge/ciphers/rc5.hpp"
+#include "dataforge/ciphers/rc6.hpp"
+
+namespace dataforge::bench {
+
+using namespace std::literals::string_view_literals;
+
+void register_cipher_benchmarks(registry& r)
+{
+    auto const key128 = "123456789abcdef0"_bs;
+    auto const key256 = "123456789abcdef0123456789abcdef0"_bs;
+    auto const iv64 = "01234567"_bs;
+    auto const iv128 = "0123456789abcdef"_bs;
+
+    // every mode of the block cipher most users pick
+    std::pair<cipher_mode_type, std::string_view> const modes[] = {
+        { cipher_mode_type::ECB, "ecb" }, { cipher_mode_type::CBC, "cbc" }, { cipher_mode_type::PCBC, "pcbc" },
+        { cipher_mode_type::CFB, "cfb" }, { cipher_mode_type::OFB, "ofb" }, { cipher_mode_type::CTR, "ctr" }
+    };
+    for (auto const& [mode, mode_name] : modes) {
+        auto const iv = mode == cipher_mode_type::ECB ? ""_bs : iv128;
+        r.add("cipher", "aes128-" + std::string{ mode_name } + "-encrypt", int8 | aes(128, key128, mode, iv, padding_type::pkcs) / int8);
+        r.add("cipher", "aes256-" + std::string{ mode_name } + "-encrypt", int8 | aes(128, key256, mode, iv, padding_type::pkcs) / int8);
+        r.add("cipher", "aes128-" + std::string{ mode_name } + "-decrypt", int8 / aes(128, key128, mode, iv, padding_type::pkcs) | int8,
+            encoded_by(int8 | aes(128, key128, mode, iv, padding_type::pkcs) / int8));
+    }
+
+    r.add("cipher", "des-cbc-encrypt", int8 | des_qrk(1, key128.first(8), cipher_mode_type::CBC, iv64, padding_type::pkcs) / int8);
+    r.add("cipher", "blowfish-cbc-encrypt", int8 | blowfish(false, key128, cipher_mode_type::CBC, iv64, padding_type::pkcs) / int8);
+    r.add("cipher", "kuznyechik-cbc-encrypt", int8 | kuznyechik(key256, cipher_mode_type::CBC, iv128, padding_type::pkcs) / int8);
+    r.add("cipher", "magma-cbc-encrypt", int8 | magma(key256, cipher_mode_type::CBC, iv64, padding_type::pkcs) / int8);
+    r.add("cipher", "belt-cbc-encrypt", int8 | belt(key256, cipher_mode_type::CBC, iv128, padding_type::pkcs) / int8);
+    r.add("cipher", "rc5-32-cbc-encrypt", int8 | rc5_qrk<32>(12, key128, cipher_mode_type::CBC, iv64, padding_type::pkcs) / int8);
+    r.add("cipher", "rc6-32-cbc-encrypt", int8 | rc6_qrk<32>(20, key128, cipher_mode_type::CBC, iv128, padding_type::pkcs) / int8);
+    r.add("cipher", "rc4", int8 | rc4_qrk(key128, 8u, 0u) / int8);
+}
+
+}
@@ -0,0 +1,206 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dataforge/quark_push_iterator.hpp"
+#include "dataforge/quark_pull_iterator.hpp"
+#include "dataforge/detail/config.hpp"
+
+namespace dataforge::bench {
+
+using input_t = std::vector<unsigned char>;
+using input_factory_t = std::function<input_t(size_t)>;
+using runner_t = std::function<size_t(std::span<const unsigned char>)>;
+
+// One benchmarked conversion: make_input(n) builds an input of about n bytes,
+// push / pull convert it and return the number of output bytes (pull is
+// empty when the chain has no pull form). Inputs above max_size are skipped,
+// for codecs whose cost is superlinear in the message size.
+struct bench_case
+{
+    std::string family;
+    std::string name;
+    input_factory_t make_input;
+    runner_t push;
+    runner_t pull;
+    size_t max_size = SIZE_MAX;
+};
+
+// deterministic incompressible bytes
+inline input_t random_bytes(size_t n)
+{
+    input_t result(n);
+    uint64_t x = 0x9e3779b97f4a7c15ull;
+    for (auto& b : result) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        b = static_cast<unsigned char>(x >> 32);
+    }
+    return result;
+}
+
+// deterministic ASCII prose, compressible roughly like natural text
+inline input_t text_bytes(size_t n)
+{
+    static const char* const words[] = {
+        "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "data", "forge",
+        "stream", "block", "cipher", "digest", "of", "and", "to", "in", "a", "converter",
+        "pipeline", "buffer", "is", "with", "for", "every", "byte", "chunk", "quark", "push"
+    };
+    input_t result;
+    result.reserve(n + 16);
+    uint64_t x = 0x2545f4914f6cdd1dull;
+    while (result.size() < n) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        std::string_view const w = words[(x >> 33) % std::size(words)];
+        result.insert(result.end(), w.begin(), w.end());
+        result.push_back((x & 0xf) == 0 ? '\n' : ' ');
+    }
+    result.resize(n);
+    return result;
+}
+
+// deterministic UTF-8 mixing 1- to 4-byte sequences and combining marks;
+// never cuts a sequence, so the result may be a few bytes shorter than n
+inline input_t utf8_bytes(size_t n)
+{
+    static const std::string_view pieces[] = {
+        "plain ascii ", "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 ", "\xE6\x97\xA5\xE6\x9C\xAC ",
+        "e\xCC\x81 ", "\xF0\x9F\x91\x8D\xF0\x9F\x8F\xBD ", "\xF0\x9F\x87\xBA\xF0\x9F\x87\xA6 "
+    };
+    input_t result;
+    uint64_t x = 0x853c49e6748fea9bull;
+    for (;;) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        std::string_view const p = pieces[(x >> 33) % std::size(pieces)];
+        if (result.size() + p.size() > n) break;
+        result.insert(result.end(), p.begin(), p.end());
+    }
+    return result;
+}
+
+// the output of chain over base(n): inputs for decoders
+template <typename ChainT>
+input_factory_t encoded_by(ChainT const& chain, input_factory_t base = random_bytes)
+{
+    return [chain, base](size_t n) {
+        input_t const src = base(n);
+        input_t result;
+        auto it = quark_push_iterator{ ChainT{ chain }, std::back_inserter(result) };
+        *it = std::span<const unsigned char>{ src };
+        it.finish();
+        return result;
+    };
+}
+
+// output iterator that only counts the bytes it receives
+struct counting_sink
+{
+    size_t bytes = 0;
+
+    counting_sink& operator*() { return *this; }
+    void operator++() {}
+
+    template <typename T>
+    counting_sink& operator=(T const& v)
+    {
+        bytes += size_of(v);
+        return *this;
+    }
+
+private:
+    template <typename T>
+    static size_t size_of(T const& v)
+    {
+        if constexpr (requires { v.size_bytes(); }) {
+            return v.size_bytes();
+        } else if constexpr (requires { v.second; }) {
+            return size_of(v.second);
+        } else {
+            return sizeof(T);
+        }
+    }
+};
+
+template <typename ChainT>
+runner_t push_runner(ChainT const& chain)
+{
+    return [chain](std::span<const unsigned char> in) {
+        counting_sink sink;
+        auto it = quark_push_iterator{ ChainT{ chain }, std::ref(sink) };
+        *it = in;
+        it.finish();
+        return sink.bytes;
+    };
+}
+
+// a chain converts in pull mode when every stage has a pull member
+template <typename ConverterT>
+concept PullableStage = requires(ConverterT& c, std::span<const typename ConverterT::input_element_type>& in) {
+    c.pull(in, [] { return std::span<const typename ConverterT::input_element_type>{}; });
+};
+
+template <typename ChainT> struct pullable_chain : std::false_type {};
+
+template <typename... ConverterTs, typename QuarksT>
+struct pullable_chain<quark_chain<std::tuple<ConverterTs...>, QuarksT>>
+    : std::bool_constant<(PullableStage<ConverterTs> && ...)> {};
+
+template <typename ChainT>
+runner_t pull_runner(ChainT const& chain)
+{
+    return [chain](std::span<const unsigned char> in) {
+        size_t bytes = 0;
+        auto it = quark_pull_iterator{ ChainT{ chain }, in };
+        for (auto sp = *it; !sp.empty(); sp = *it) {
+            bytes += sp.size_bytes();
+            ++it;
+        }
+        return bytes;
+    };
+}
+
+class registry
+{
+public:
+    // registers the chain in push mode, and in pull mode when it has one
+    template <typename ChainT>
+    bench_case& add(std::string family, std::string name, ChainT const& chain, input_factory_t make_input = random_bytes)
+    {
+        runner_t pull;
+        if constexpr (pullable_chain<ChainT>::value) pull = pull_runner(chain);
+        return cases_.emplace_back(bench_case{ std::move(family), std::move(name), std::move(make_input), push_runner(chain), std::move(pull) });
+    }
+
+    template <typename ChainT>
+    bench_case& add_push_only(std::string family, std::string name, ChainT const& chain, input_factory_t make_input = random_bytes)
+    {
+        return cases_.emplace_back(bench_case{ std::move(family), std::move(name), std::move(make_input), push_runner(chain), {} });
+    }
+
+    std::vector<bench_case> const& cases() const noexcept { return cases_; }
+
+private:
+    std::vector<bench_case> cases_;
+};
+
+void register_checksum_benchmarks(registry&);
+void register_base_xx_benchmarks(registry&);
+void register_hash_benchmarks(registry&);
+void register_cipher_benchmarks(registry&);
+void register_compression_benchmarks(registry&);
+void register_unicode_benchmarks(registry&);
+
+}
@@ -0,0 +1,40 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "bench_common.hpp"
+
+#include "dataforge/compression/deflate.hpp"
+#include "dataforge/compression/bzip2.hpp"
+#include "dataforge/compression/lz4.hpp"
+#include "dataforge/compression/lzma.hpp"
+
+namespace dataforge::bench {
+
+void register_compression_benchmarks(registry& r)
+{
+    for (int level : { 1, 6, 9 }) {
+        r.add("compression", "deflate-" + std::to_string(level), int8 | deflated(false, 65536, level), text_bytes);
+    }
+    r.add("compression", "inflate", int8 | inflated(false), encoded_by(int8 | deflated(false, 65536, 6), text_bytes));
+
+    for (uint_least8_t block_size : { 1, 9 }) {
+        r.add("compression", "bzip2-" + std::to_string(block_size), int8 | bzip2(65536, block_size), text_bytes);
+    }
+    r.add("compression", "bunzip2", bzip2() | int8, encoded_by(int8 | bzip2(), text_bytes));
+
+    for (int level : { 0, 9 }) {
+        r.add("compression", "lz4-" + std::to_string(level), int8 | lz4(level), text_bytes);
+    }
+    r.add("compression", "lz4-decompress", lz4() | int8, encoded_by(int8 | lz4(), text_bytes));
+
+    for (uint32_t preset : { 0u, 6u }) {
+        r.add("compression", "lzma2-" + std::to_string(preset), int8 | lzma2(preset), text_bytes);
+    }
+    r.add("compression", "lzma2-decompress", lzma2() | int8, encoded_by(int8 | lzma2(), text_bytes));
+}
+
+}
@@ -0,0 +1,44 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "bench_common.hpp"
+
+#include "dataforge/hashes/md5.hpp"
+#include "dataforge/hashes/sha1.hpp"
+#include "dataforge/hashes/sha2.hpp"
+#include "dataforge/hashes/sha3.hpp"
+#include "dataforge/hashes/blake.hpp"
+#include "dataforge/hashes/ripemd.hpp"
+#include "dataforge/hashes/whirlpool.hpp"
+#include "dataforge/hashes/tiger.hpp"
+#include "dataforge/hashes/streebog.hpp"
+#include "dataforge/hashes/gost.hpp"
+
+namespace dataforge::bench {
+
+void register_hash_benchmarks(registry& r)
+{
+    r.add("hash", "md5", int8 | md5);
+    r.add("hash", "sha1", int8 | sha1);
+    r.add("hash", "sha224", int8 | sha224);
+    r.add("hash", "sha256", int8 | sha256);
+    r.add("hash", "sha384", int8 | sha384);
+    r.add("hash", "sha512", int8 | sha512);
+    r.add("hash", "sha3-256", int8 | sha3_256);
+    r.add("hash", "sha3-512", int8 | sha3_512);
+    r.add("hash", "blake256", int8 | blake256);
+    r.add("hash", "blake2s256", int8 | blake2s256);
+    r.add("hash", "blake2b512", int8 | blake2b512);
+    r.add("hash", "ripemd160", int8 | ripemd160);
+    r.add("hash", "whirlpool", int8 | whirlpool);
+    r.add("hash", "tiger192", int8 | tiger192_3);
+    r.add("hash", "streebog256", int8 | streebog256);
+    r.add("hash", "streebog512", int8 | streebog512);
+    r.add("hash", "gost", int8 | gost);
+}
+
+}
@@ -0,0 +1,286 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "bench_common.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+
+#include "dataforge/backend_report.hpp"
+
+#ifndef DATAFORGE_BENCH_PROFILE
+#   define DATAFORGE_BENCH_PROFILE "custom"
+#endif
+
+namespace dataforge::bench {
+
+struct options
+{
+    std::vector<size_t> sizes{ 16, 256, 4096, 65536, 1u << 20, 64u << 20 };
+    std::string filter;             // substring of "family/name"
+    bool push = true;
+    bool pull = true;
+    double min_time = 0.2;          // seconds per measurement
+    std::string json_path;
+    std::string baseline_path;
+    double threshold = 0.05;        // relative slowdown reported as a regression
+    bool list = false;
+};
+
+struct result
+{
+    std::string family;
+    std::string name;
+    std::string mode;
+    size_t size;
+    size_t iterations;
+    double ns_per_call;
+    double mb_per_s;
+};
+
+inline void usage()
+{
+    std::cout <<
+        "usage: dataforge_bench [options]\n"
+        "  --filter <text>      run the cases whose family/name contains text\n"
+        "  --sizes <n,n,...>    message sizes in bytes (k, m suffixes allowed)\n"
+        "  --max-size <n>       drop the default sizes above n\n"
+        "  --mode push|pull     run one mode only (default: both)\n"
+        "  --min-time <ms>      minimal measured time per result (default 200)\n"
+        "  --quick              --max-size 1m --min-time 20\n"
+        "  --json <file>        write the results as JSON\n"
+        "  --baseline <file>    compare with the JSON of an earlier run\n"
+        "  --threshold <pct>    slowdown reported as a regression (default 5)\n"
+        "  --list               list the cases and exit\n";
+}
+
+inline size_t parse_size(std::string_view s)
+{
+    size_t scale = 1;
+    if (!s.empty() && (s.back() == 'k' || s.back() == 'K')) { scale = 1024; s.remove_suffix(1); }
+    else if (!s.empty() && (s.back() == 'm' || s.back() == 'M')) { scale = 1024 * 1024; s.remove_suffix(1); }
+    return std::stoull(std::string{ s }) * scale;
+}
+
+inline options parse_options(int argc, char** argv)
+{
+    options opts;
+    auto value = [&](int& i) -> std::string_view {
+        if (i + 1 >= argc) throw std::runtime_error(std::string{ "missing value of " } + argv[i]);
+        return argv[++i];
+    };
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const arg = argv[i];
+        if (arg == "--filter") opts.filter = value(i);
+        else if (arg == "--sizes") {
+            opts.sizes.clear();
+            std::istringstream is{ std::string{ value(i) } };
+            for (std::string s; std::getline(is, s, ',');) opts.sizes.push_back(parse_size(s));
+        }
+        else if (arg == "--max-size") {
+            size_t const max_size = parse_size(value(i));
+            std::erase_if(opts.sizes, [max_size](size_t s) { return s > max_size; });
+        }
+        else if (arg == "--mode") {
+            std::string_view const m = value(i);
+            if (m != "push" && m != "pull") throw std::runtime_error("--mode is push or pull");
+            opts.push = m == "push";
+            opts.pull = m == "pull";
+        }
+        else if (arg == "--min-time") opts.min_time = std::stod(std::string{ value(i) }) / 1000;
+        else if (arg == "--quick") {
+            std::erase_if(opts.sizes, [](size_t s) { return s > (1u << 20); });
+            opts.min_time = 0.02;
+        }
+        else if (arg == "--json") opts.json_path = value(i);
+        else if (arg == "--baseline") opts.baseline_path = value(i);
+        else if (arg == "--threshold") opts.threshold = std::stod(std::string{ value(i) }) / 100;
+        else if (arg == "--list") opts.list = true;
+        else if (arg == "--help" || arg == "-h") { usage(); std::exit(0); }
+        else throw std::runtime_error("unknown option " + std::string{ arg });
+    }
+    return opts;
+}
+
+// runs fn repeatedly for at least min_time seconds, after one warm-up call
+inline result measure(bench_case const& c, std::string mode, runner_t const& fn, std::span<const unsigned char> input, double min_time)
+{
+    using clock = std::chrono::steady_clock;
+    fn(input);
+    size_t iterations = 0;
+    clock::duration elapsed{};
+    auto const start = clock::now();
+    do {
+        fn(input);
+        ++iterations;
+        elapsed = clock::now() - start;
+    } while (std::chrono::duration<double>(elapsed).count() < min_time);
+
+    double const seconds = std::chrono::duration<double>(elapsed).count();
+    return result{ c.family, c.name, std::move(mode), input.size(), iterations,
+        seconds * 1e9 / iterations, input.size() * static_cast<double>(iterations) / seconds / 1e6 };
+}
+
+inline std::string json_string(std::string_view s)
+{
+    std::string r = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') r += '\\';
+        r += ch;
+    }
+    return r += '"';
+}
+
+// one result object per line, which is what read_baseline() relies on
+inline void write_json(std::ostream& os, std::vector<result> const& results)
+{
+    os << "{\n  \"dataforge_bench\": 1,\n  \"profile\": " << json_string(DATAFORGE_BENCH_PROFILE) << ",\n  \"backends\": [";
+    auto const backends = backend_report();
+    for (size_t i = 0; i < backends.size(); ++i) {
+        os << (i ? ", " : "") << "{ \"algorithm\": " << json_string(backends[i].algorithm) << ", \"backend\": " << json_string(backends[i].backend) << " }";
+    }
+    os << "],\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        result const& r = results[i];
+        char numbers[160];
+        std::snprintf(numbers, sizeof(numbers), "\"size\": %zu, \"iterations\": %zu, \"ns_per_call\": %.1f, \"mb_per_s\": %.3f",
+            r.size, r.iterations, r.ns_per_call, r.mb_per_s);
+        os << "    { \"family\": " << json_string(r.family) << ", \"name\": " << json_string(r.name)
+           << ", \"mode\": " << json_string(r.mode) << ", " << numbers << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "  ]\n}\n";
+}
+
+inline std::string json_field(std::string const& line, std::string_view key)
+{
+    std::string const tag = "\"" + std::string{ key } + "\": ";
+    size_t pos = line.find(tag);
+    if (pos == std::string::npos) return {};
+    pos += tag.size();
+    if (line[pos] == '"') {
+        std::string value;
+        for (++pos; pos < line.size() && line[pos] != '"'; ++pos) {
+            if (line[pos] == '\\') ++pos;
+            value += line[pos];
+        }
+        return value;
+    }
+    return line.substr(pos, line.find_first_of(",}", pos) - pos);
+}
+
+// reads the results of a file written by write_json()
+inline std::vector<result> read_baseline(std::string const& path, std::string& profile)
+{
+    std::ifstream is{ path };
+    if (!is) throw std::runtime_error("can't open the baseline " + path);
+    std::vector<result> results;
+    for (std::string line; std::getline(is, line);) {
+        if (line.find("\"profile\": ") != std::string::npos) profile = json_field(line, "profile");
+        if (line.find("\"family\": ") == std::string::npos) continue;
+        results.push_back(result{ json_field(line, "family"), json_field(line, "name"), json_field(line, "mode"),
+            std::stoull(json_field(line, "size")), std::stoull(json_field(line, "iterations")),
+            std::stod(json_field(line, "ns_per_call")), std::stod(json_field(line, "mb_per_s")) });
+    }
+    return results;
+}
+
+// prints the change of every result present in both runs; returns the
+// number of regressions beyond the threshold
+inline size_t compare(std::vector<result> const& results, options const& opts)
+{
+    std::string profile;
+    std::vector<result> const baseline = read_baseline(opts.baseline_path, profile);
+    if (profile != DATAFORGE_BENCH_PROFILE) {
+        std::cout << "note: the baseline was measured with the '" << profile << "' profile\n";
+    }
+    std::map<std::tuple<std::string, std::string, std::string, size_t>, double> base;
+    for (result const& r : baseline) base[{ r.family, r.name, r.mode, r.size }] = r.mb_per_s;
+
+    size_t regressions = 0;
+    std::printf("\n%-36s %-4s %10s %12s %12s %8s\n", "case", "mode", "size", "base MB/s", "MB/s", "change");
+    for (result const& r : results) {
+        auto it = base.find({ r.family, r.name, r.mode, r.size });
+        if (it == base.end() || it->second <= 0) continue;
+        double const change = r.mb_per_s / it->second - 1;
+        bool const regression = change < -opts.threshold;
+        regressions += regression;
+        std::printf("%-36s %-4s %10zu %12.2f %12.2f %+7.1f%%%s\n", (r.family + "/" + r.name).c_str(), r.mode.c_str(), r.size,
+            it->second, r.mb_per_s, change * 100, regression ? "  REGRESSION" : "");
+    }
+    std::printf("%zu regression(s) beyond %.1f%%\n", regressions, opts.threshold * 100);
+    return regressions;
+}
+
+inline int run(int argc, char** argv)
+{
+    options const opts = parse_options(argc, argv);
+
+    registry r;
+    register_checksum_benchmarks(r);
+    register_base_xx_benchmarks(r);
+    register_hash_benchmarks(r);
+    register_cipher_benchmarks(r);
+    register_compression_benchmarks(r);
+    register_unicode_benchmarks(r);
+
+    std::vector<bench_case const*> selected;
+    for (bench_case const& c : r.cases()) {
+        if ((c.family + "/" + c.name).find(opts.filter) != std::string::npos) selected.push_back(&c);
+    }
+    if (opts.list) {
+        for (bench_case const* c : selected) std::cout << c->family << '/' << c->name << (c->pull ? "" : " (push only)") << '\n';
+        return 0;
+    }
+
+    std::cout << "profile: " << DATAFORGE_BENCH_PROFILE;
+    for (auto const& [algorithm, backend] : backend_report()) std::cout << ", " << algorithm << ": " << backend;
+    std::printf("\n%-36s %-4s %10s %12s %14s\n", "case", "mode", "size", "MB/s", "ns/call");
+
+    std::vector<result> results;
+    for (bench_case const* c : selected) {
+        for (size_t size : opts.sizes) {
+            if (size > c->max_size) continue;
+            input_t const input = c->make_input(size);
+            for (auto const& [enabled, mode, fn] : { std::tuple{ opts.push, "push", &c->push }, std::tuple{ opts.pull, "pull", &c->pull } }) {
+                if (!enabled || !*fn) continue;
+                result const& res = results.emplace_back(measure(*c, mode, *fn, input, opts.min_time));
+                std::printf("%-36s %-4s %10zu %12.2f %14.1f\n", (c->family + "/" + c->name).c_str(), mode, res.size, res.mb_per_s, res.ns_per_call);
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    if (!opts.json_path.empty()) {
+        std::ofstream os{ opts.json_path };
+        write_json(os, results);
+        if (!os) throw std::runtime_error("can't write " + opts.json_path);
+    }
+    if (!opts.baseline_path.empty() && compare(results, opts)) {
+        return 2;
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    try {
+        return dataforge::bench::run(argc, argv);
+    } catch (std::exception const& e) {
+        std::cerr << "dataforge_bench: " << e.what() << '\n';
+        return 1;
+    }
+}
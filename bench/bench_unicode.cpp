@@ -0,0 +1,24 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "bench_common.hpp"
+
+#include "dataforge/unicode/utf.hpp"
+#include "dataforge/basic/mapper.hpp"
+
+namespace dataforge::bench {
+
+void register_unicode_benchmarks(registry& r)
+{
+    r.add("unicode", "utf8-to-utf16", utf8 | utf16, utf8_bytes);
+    r.add("unicode", "utf8-to-utf32", utf8 | utf32, utf8_bytes);
+    r.add("unicode", "utf16le-to-utf8", le | utf16 | utf8, encoded_by(utf8 | utf16 | le, utf8_bytes));
+    r.add("unicode", "utf8-to-utf7", utf8 | utf16 | utf7, utf8_bytes);
+    r.add_push_only("unicode", "utf8-graphemes", utf8 | utf32 | enumerated_graphemes | seq_mapper(utf32 | utf8), utf8_bytes);
+}
+
+}
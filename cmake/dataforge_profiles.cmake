@@ -0,0 +1,176 @@
+# ---------------------------------------------------------------------------
+# Profile constants — mirror DATAFORGE_PROFILE_* values from config.hpp.
+# Use these names everywhere so the numeric values are never written
+# directly in a CMakeLists.
+# ---------------------------------------------------------------------------
+set(PROFILE_AUTO       -1)
+set(PROFILE_SCALAR      0)
+set(PROFILE_X86_SHA_NI  1)
+set(PROFILE_X86_AVX512  2)
+set(PROFILE_ARM_NEON    3)
+set(PROFILE_ARM_SHA     4)
+set(PROFILE_ARM_CRYPTO  5)
+
+# ---------------------------------------------------------------------------
+# Runtime CPU capability probes (executed at CMake configure time).
+# Each probe program returns 0 if the CPU feature is present, 1 otherwise.
+# Results are cached; re-run cmake to re-probe (e.g. after changing machines).
+# ---------------------------------------------------------------------------
+include(CheckCXXSourceRuns)
+
+# Probe: x86 SHA-NI (CPUID leaf 7, EBX bit 29)
+set(PROBE_X86_SHA_NI [=[
+    #if defined(_MSC_VER)
+    #  include <intrin.h>
+    #else
+    #  include <cpuid.h>
+    #endif
+    int main() {
+    #if defined(_MSC_VER)
+        int info[4]; __cpuidex(info, 7, 0);
+        return ((info[1] >> 29) & 1) ? 0 : 1;
+    #else
+        unsigned a, b, c, d;
+        if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) return 1;
+        return ((b >> 29) & 1) ? 0 : 1;
+    #endif
+    }
+]=])
+
+# Probe: x86 AVX-512F + AVX-512VL + OS register-state support (XCR0 bits)
+set(PROBE_X86_AVX512 [=[
+    #if defined(_MSC_VER)
+    #  include <intrin.h>
+    #  include <immintrin.h>
+    #else
+    #  include <cpuid.h>
+    #endif
+    int main() {
+    #if defined(_MSC_VER)
+        int info[4]; __cpuidex(info, 7, 0);
+        if (!((info[1] >> 16) & 1) || !((info[1] >> 31) & 1)) return 1;
+        unsigned long long xcr0 = _xgetbv(0);
+    #else
+        unsigned a, b, c, d;
+        if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) return 1;
+        if (!((b >> 16) & 1) || !((b >> 31) & 1)) return 1;
+        unsigned eax2, edx2;
+        __asm__("xgetbv" : "=a"(eax2), "=d"(edx2) : "c"(0u));
+        unsigned long long xcr0 = ((unsigned long long)edx2 << 32) | eax2;
+    #endif
+        // Bits 1-2: SSE, bits 5-7: AVX-512 opmask/ZMM-hi/ZMM-hi16
+        return ((xcr0 & 0xE6u) == 0xE6u) ? 0 : 1;
+    }
+]=])
+
+# Probe: AArch64 SHA2 crypto extension (SHA-1 / SHA-224 / SHA-256)
+# Required by ARM_SHA and ARM_CRYPTO profiles.
+set(PROBE_ARM_SHA [=[
+    #if defined(__APPLE__)
+    #  include <sys/sysctl.h>
+    int main() {
+        int v = 0; size_t sz = sizeof(v);
+        sysctlbyname("hw.optional.arm.FEAT_SHA256", &v, &sz, nullptr, 0);
+        return v ? 0 : 1;
+    }
+    #elif defined(__linux__)
+    #  include <sys/auxv.h>
+    #  include <asm/hwcap.h>
+    int main() { return (getauxval(AT_HWCAP) & HWCAP_SHA2) ? 0 : 1; }
+    #else
+    int main() { return 1; }
+    #endif
+]=])
+
+# Probe: AArch64 SHA-512 hardware extension (ARMv8.2-A, SHA-384 / SHA-512).
+# Required by ARM_CRYPTO profile in addition to SHA2.
+set(PROBE_ARM_SHA512_EXT [=[
+    #if defined(__APPLE__)
+    #  include <sys/sysctl.h>
+    int main() {
+        int v = 0; size_t sz = sizeof(v);
+        sysctlbyname("hw.optional.arm.FEAT_SHA512", &v, &sz, nullptr, 0);
+        return v ? 0 : 1;
+    }
+    #elif defined(__linux__)
+    #  include <sys/auxv.h>
+    #  include <asm/hwcap.h>
+    #  ifndef HWCAP_SHA512
+    #    define HWCAP_SHA512 (1UL << 21)
+    #  endif
+    int main() { return (getauxval(AT_HWCAP) & HWCAP_SHA512) ? 0 : 1; }
+    #else
+    int main() { return 1; }
+    #endif
+]=])
+
+# ---------------------------------------------------------------------------
+# DATAFORGE_HOST_PROFILES: the profiles whose binaries can run on this host,
+# with DATAFORGE_PROFILE_VALUE_<name> holding each DATAFORGE_PROFILE_* value.
+# AUTO and SCALAR are always present.
+# ---------------------------------------------------------------------------
+set(DATAFORGE_HOST_PROFILES auto scalar)
+set(DATAFORGE_PROFILE_VALUE_auto   ${PROFILE_AUTO})
+set(DATAFORGE_PROFILE_VALUE_scalar ${PROFILE_SCALAR})
+set(_dataforge_profile_report
+    "  [enabled] auto   (DATAFORGE_ACCEL_PROFILE=${PROFILE_AUTO})"
+    "  [enabled] scalar (DATAFORGE_ACCEL_PROFILE=${PROFILE_SCALAR})")
+
+macro(_dataforge_host_profile NAME VALUE)
+    list(APPEND DATAFORGE_HOST_PROFILES ${NAME})
+    set(DATAFORGE_PROFILE_VALUE_${NAME} ${VALUE})
+    list(APPEND _dataforge_profile_report "  [enabled] ${NAME} (DATAFORGE_ACCEL_PROFILE=${VALUE})")
+endmacro()
+
+# x86 profiles
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "AMD64|x86_64|i[3-6]86|X86")
+
+    check_cxx_source_runs("${PROBE_X86_SHA_NI}"  DATAFORGE_CPU_HAS_X86_SHA_NI)
+    check_cxx_source_runs("${PROBE_X86_AVX512}"  DATAFORGE_CPU_HAS_X86_AVX512)
+
+    if(DATAFORGE_CPU_HAS_X86_SHA_NI)
+        _dataforge_host_profile(x86_sha_ni ${PROFILE_X86_SHA_NI})
+    else()
+        list(APPEND _dataforge_profile_report "  [skipped] x86_sha_ni — SHA-NI not available on this CPU")
+    endif()
+
+    if(DATAFORGE_CPU_HAS_X86_AVX512)
+        _dataforge_host_profile(x86_avx512 ${PROFILE_X86_AVX512})
+    else()
+        list(APPEND _dataforge_profile_report "  [skipped] x86_avx512 — AVX-512 not available on this CPU")
+    endif()
+
+endif()
+
+# AArch64 profiles
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "aarch64|arm64|ARM64|AARCH64")
+
+    # ARM_NEON: NEON is mandatory on all AArch64 — always build.
+    _dataforge_host_profile(arm_neon ${PROFILE_ARM_NEON})
+
+    check_cxx_source_runs("${PROBE_ARM_SHA}"        DATAFORGE_CPU_HAS_ARM_SHA)
+    check_cxx_source_runs("${PROBE_ARM_SHA512_EXT}" DATAFORGE_CPU_HAS_ARM_SHA512_EXT)
+
+    if(DATAFORGE_CPU_HAS_ARM_SHA)
+        _dataforge_host_profile(arm_sha ${PROFILE_ARM_SHA})
+    else()
+        list(APPEND _dataforge_profile_report "  [skipped] arm_sha — SHA2 crypto extension not available on this CPU")
+    endif()
+
+    if(DATAFORGE_CPU_HAS_ARM_SHA AND DATAFORGE_CPU_HAS_ARM_SHA512_EXT)
+        _dataforge_host_profile(arm_crypto ${PROFILE_ARM_CRYPTO})
+    else()
+        list(APPEND _dataforge_profile_report "  [skipped] arm_crypto — SHA-512 extension (ARMv8.2-A) not available on this CPU")
+    endif()
+
+endif()
+
+# report once per configure, however many directories include this file
+get_property(_dataforge_profiles_reported GLOBAL PROPERTY DATAFORGE_PROFILES_REPORTED)
+if(NOT _dataforge_profiles_reported)
+    message(STATUS "DataForge: acceleration profiles supported by this host")
+    foreach(_line IN LISTS _dataforge_profile_report)
+        message(STATUS "${_line}")
+    endforeach()
+    set_property(GLOBAL PROPERTY DATAFORGE_PROFILES_REPORTED TRUE)
+endif()
@@ -0,0 +1,198 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "pull_converter.hpp"
+#include "detail/utility/spsc_ring.hpp"
+
+namespace dataforge {
+
+// A pull iterator that reads ahead: a worker thread pulls the chain and
+// collects the output into chunks of about chunk_bytes while the consumer
+// processes the current one. At most BuffersV chunks wait for the consumer,
+// so the memory stays bounded by BuffersV + 2 chunks. An exception thrown
+// by the chain is rethrown from operator* or operator++ in order, after the
+// output pulled before it.
+//
+// The input the converter reads has to outlive the iterator, as with
+// quark_pull_iterator.
+template <typename ConverterT, size_t BuffersV = 3>
+class async_pull_iterator
+{
+    static_assert(BuffersV > 0);
+
+    using element_type = std::remove_const_t<typename ConverterT::output_element_type>;
+    using buffer_t = std::vector<element_type>;
+
+public:
+    using value_type = std::span<const element_type>;
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type;
+
+    explicit async_pull_iterator(ConverterT&& cvt, size_t chunk_bytes = 64 * 1024)
+        : state_{ std::make_unique<state>(std::move(cvt), chunk_bytes) }
+    {
+        start();
+    }
+
+    template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT>
+    async_pull_iterator(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&& chain, BaseIteratorArgT&& it, size_t chunk_bytes = 64 * 1024)
+        : async_pull_iterator{ ConverterT{ std::move(chain), std::forward<BaseIteratorArgT>(it) }, chunk_bytes }
+    {}
+
+    async_pull_iterator(async_pull_iterator&&) noexcept = default;
+    async_pull_iterator& operator=(async_pull_iterator&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            stop();
+            state_ = std::move(rhs.state_);
+        }
+        return *this;
+    }
+
+    ~async_pull_iterator() { stop(); }
+
+    value_type operator*()
+    {
+        if (!state_->started) fetch();
+        return state_->current;
+    }
+
+    async_pull_iterator& operator++()
+    {
+        fetch();
+        return *this;
+    }
+
+private:
+    struct chunk
+    {
+        buffer_t data;
+        std::exception_ptr error;
+        bool last = false;
+    };
+
+    struct state
+    {
+        ConverterT cvt;
+        size_t chunk_elements;
+        spsc_ring<chunk> ready{ BuffersV };
+        spsc_ring<buffer_t> spare{ BuffersV + 2 };
+        std::atomic<bool> stopping{ false };
+        std::thread worker;
+
+        // consumer side
+        buffer_t current;
+        bool started = false;
+        bool done = false;
+
+        state(ConverterT&& c, size_t chunk_bytes)
+            : cvt{ std::move(c) }
+            , chunk_elements{ (std::max)(chunk_bytes / sizeof(element_type), size_t{ 1 }) }
+        {}
+
+        void produce()
+        {
+            for (;;) {
+                chunk c;
+                if (!spare.try_pop(c.data)) c.data.reserve(chunk_elements);
+                try {
+                    while (c.data.size() < chunk_elements) {
+                        if (stopping.load(std::memory_order_relaxed)) {
+                            c.last = true;
+                            break;
+                        }
+                        auto const sp = cvt.pull();
+                        if (sp.empty()) {
+                            c.last = true;
+                            break;
+                        }
+                        c.data.insert(c.data.end(), sp.begin(), sp.end());
+                    }
+                } catch (...) {
+                    // the output pulled before the failure comes out first
+                    if (!c.data.empty()) {
+                        chunk partial;
+                        partial.data = std::move(c.data);
+                        ready.push(std::move(partial));
+                        c.data = {};
+                    }
+                    c.error = std::current_exception();
+                    c.last = true;
+                }
+                bool const last = c.last;
+                ready.push(std::move(c));
+                if (last) return;
+            }
+        }
+    };
+
+    void start()
+    {
+        state_->worker = std::thread{ [st = state_.get()] { st->produce(); } };
+    }
+
+    void fetch()
+    {
+        state& st = *state_;
+        st.started = true;
+        if (!st.current.empty()) {
+            st.current.clear();
+            st.spare.try_push(std::move(st.current));
+            st.current = {};
+        }
+        if (st.done) return;
+        chunk c = st.ready.pop();
+        st.done = c.last;
+        if (c.error) std::rethrow_exception(c.error);
+        st.current = std::move(c.data);
+    }
+
+    // an abandoned iterator stops the worker and drains the chunks it is
+    // blocked on
+    void stop() noexcept
+    {
+        if (!state_) return;
+        state& st = *state_;
+        if (!st.done) {
+            st.stopping = true;
+            while (!st.ready.pop().last) {}
+        }
+        st.worker.join();
+        state_.reset();
+    }
+
+    std::unique_ptr<state> state_;
+};
+
+template <typename ConverterT>
+async_pull_iterator(ConverterT&&)->async_pull_iterator<ConverterT>;
+
+template <typename ConverterT>
+async_pull_iterator(ConverterT&&, size_t)->async_pull_iterator<ConverterT>;
+
+template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT>
+async_pull_iterator(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, BaseIteratorArgT&&)
+    ->async_pull_iterator<pull_converter<CvtTupleT, std::remove_cvref_t<BaseIteratorArgT>>>;
+
+template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT>
+async_pull_iterator(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, BaseIteratorArgT&&, size_t)
+    ->async_pull_iterator<pull_converter<CvtTupleT, std::remove_cvref_t<BaseIteratorArgT>>>;
+
+}
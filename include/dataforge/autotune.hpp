@@ -0,0 +1,33 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <string>
+
+#include "detail/autotune.hpp"
+#include "backend_report.hpp"
+
+namespace dataforge {
+
+// Enables the kernel autotuner (see detail/autotune.hpp) and tunes every
+// registered algorithm now instead of at its first use. A non-empty
+// wisdom_path is read for earlier results and updated with new ones.
+// Algorithms that already ran keep their backend, so call it at startup.
+// Returns the resulting backend report.
+inline std::vector<backend_entry> autotune(std::string wisdom_path = {})
+{
+    autotune_settings& settings = autotune_config();
+    {
+        std::lock_guard lock{ settings.wisdom_mutex };
+        settings.enabled = true;
+        if (!wisdom_path.empty()) settings.wisdom_path = std::move(wisdom_path);
+    }
+    return backend_report();
+}
+
+}
@@ -0,0 +1,37 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include "detail/cpu_features.hpp"
+
+namespace dataforge {
+
+struct backend_entry
+{
+    std::string_view algorithm;
+    std::string_view backend;   // e.g. "sha-ni", "avx2", "armv8-sha2", "scalar"
+};
+
+// The kernel backend every accelerated algorithm of the program runs with,
+// sorted by algorithm name. An algorithm is listed once its header has been
+// included in some translation unit of the program.
+inline std::vector<backend_entry> backend_report()
+{
+    std::vector<backend_entry> result;
+    for (auto const& [algorithm, query] : backend_registry()) {
+        result.push_back(backend_entry{ algorithm, query() });
+    }
+    std::sort(result.begin(), result.end(), [](backend_entry const& l, backend_entry const& r) { return l.algorithm < r.algorithm; });
+    return result;
+}
+
+}
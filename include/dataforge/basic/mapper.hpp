@@ -84,6 +84,9 @@ struct tagged_converter
     inline ChainT& chain() const noexcept { return chain_; }
     inline tagged_converter& consumer() noexcept { return *this; }
 
+    // the mapped chains are timed as a part of the mapper stage
+    static constexpr instrumentation_state<no_instrumentation, chain_size> instrumentation() noexcept { return {}; }
+
     inline tagged_converter& operator*() noexcept { return *this; }
     inline void operator++() noexcept {}
 
@@ -0,0 +1,89 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../detail/quarks.hpp"
+#include "mapper.hpp"
+
+namespace dataforge {
+
+// Feeds every input to several chains in one pass:
+//     int8 | tee(int8 | sha256, int8 | crc32, int8 | deflated())
+// The branches share the input element type. The output of branch I reaches
+// the consumer as std::pair{ std::integral_constant<size_t, I>, fragment },
+// in the way tagged_mapper tags the output of its cases; tee_consumer routes
+// it to a consumer per branch.
+template <typename ... ChainsT>
+struct tee_qrk : cvt_qrk<void>
+{
+    std::tuple<ChainsT ...> chains;
+
+    explicit tee_qrk(ChainsT&& ... c) : chains{ std::move(c) ... } {}
+};
+
+template <typename ... ChainsT>
+requires(sizeof ...(ChainsT) > 0)
+inline tee_qrk<ChainsT ...> tee(ChainsT ... chains)
+{
+    return tee_qrk<ChainsT ...>(std::move(chains) ...);
+}
+
+// The consumer of a tee: the output of branch I goes to the I-th consumer,
+// which can be anything a push converter writes to (an output iterator, a
+// back_inserter, a callable, std::ref of a sink). flush() and finish() are
+// passed on to the consumers that opted in to them (is_flushing_consumer).
+//     std::string digest, crc, packed;
+//     push_converter cvt{ int8 | tee(...), tee_consumer{ std::back_inserter(digest), ... } };
+template <typename ... ConsumersT>
+struct tee_consumer
+{
+    using consumer_category = flushing_consumer_tag;
+
+    std::tuple<ConsumersT ...> consumers;
+
+    explicit tee_consumer(ConsumersT ... c) : consumers{ std::move(c) ... } {}
+
+    template <size_t I, typename DataT>
+    void operator()(std::pair<std::integral_constant<size_t, I>, DataT> const& fragment)
+    {
+        last_consumer{ branch<I>() }(fragment.second);
+    }
+
+    void flush()
+    {
+        std::apply([](auto& ... c) { (flush_consumer(unwrap(c)), ...); }, consumers);
+    }
+
+    void finish()
+    {
+        std::apply([](auto& ... c) { (finish_consumer(unwrap(c)), ...); }, consumers);
+    }
+
+    template <size_t I>
+    auto& branch() noexcept { return unwrap(std::get<I>(consumers)); }
+
+private:
+    template <typename T>
+    static auto& unwrap(T& c) noexcept
+    {
+        if constexpr (is_reference_wrapper_v<T>) {
+            return c.get();
+        } else {
+            return c;
+        }
+    }
+};
+
+}
+
+#include "../detail/basic/tee_pusher.hpp"
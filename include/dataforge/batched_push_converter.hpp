@@ -0,0 +1,212 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "push_converter.hpp"
+
+namespace dataforge {
+
+namespace batched_push_detail {
+
+// the type-erased converter: spans only, no per-element calls
+template <typename ET>
+struct erased_push_converter
+{
+    virtual ~erased_push_converter() = default;
+
+    virtual void push(std::span<const ET> elems) = 0;
+    virtual void flush() = 0;
+    virtual void finish() = 0;
+    virtual void reset() = 0;
+
+    // moves the converter into the inline storage of another wrapper
+    virtual erased_push_converter* move_to(void* place) noexcept = 0;
+};
+
+template <typename ET, typename ConverterT>
+struct erased_push_converter_impl final : erased_push_converter<ET>
+{
+    ConverterT cvt;
+
+    explicit erased_push_converter_impl(ConverterT&& c) : cvt{ std::move(c) } {}
+
+    void push(std::span<const ET> elems) override { cvt.push(elems); }
+    void flush() override { cvt.flush(); }
+    void finish() override { cvt.finish(); }
+
+    void reset() override
+    {
+        if constexpr (requires { cvt.reset(); }) cvt.reset();
+    }
+
+    erased_push_converter<ET>* move_to(void* place) noexcept override
+    {
+        return ::new (place) erased_push_converter_impl{ std::move(cvt) };
+    }
+};
+
+}
+
+// A runtime-chosen push converter like dynamic_push_converter, for pipelines
+// built from a configuration, without its per-element virtual calls:
+//     batched_push_converter<uint8_t> cvt{ int8 | base64, std::back_inserter(out) };
+//     for (uint8_t b : input) cvt.push(b);
+//     cvt.finish();
+// Single elements and short spans are gathered into a batch of BatchV
+// elements that crosses the virtual interface as one span; longer spans go
+// through as they are, after the batch. The converter is kept in InlineBytesV
+// bytes inside the object when it fits and is nothrow movable, otherwise on
+// the heap. Output that is still in the batch comes out on flush() or finish().
+template <typename ET, size_t InlineBytesV = 256, size_t BatchV = 256>
+class batched_push_converter
+{
+    using erased_t = batched_push_detail::erased_push_converter<ET>;
+
+    template <typename ConverterT>
+    using impl_t = batched_push_detail::erased_push_converter_impl<ET, std::remove_cvref_t<ConverterT>>;
+
+    template <typename ConverterT>
+    static constexpr bool fits_inline = sizeof(impl_t<ConverterT>) <= InlineBytesV &&
+        alignof(impl_t<ConverterT>) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<std::remove_cvref_t<ConverterT>>;
+
+public:
+    static_assert(BatchV > 0);
+
+    template <typename ConverterT>
+    requires(!std::is_same_v<std::remove_cvref_t<ConverterT>, batched_push_converter>)
+    explicit batched_push_converter(ConverterT&& cvt)
+    {
+        std::remove_cvref_t<ConverterT> c{ std::forward<ConverterT>(cvt) };
+        if constexpr (fits_inline<ConverterT>) {
+            cvt_ = ::new (static_cast<void*>(storage_)) impl_t<ConverterT>{ std::move(c) };
+            inline_ = true;
+        } else {
+            cvt_ = new impl_t<ConverterT>{ std::move(c) };
+        }
+    }
+
+    template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT>
+    batched_push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&& chain, BaseIteratorArgT&& it)
+        : batched_push_converter{ push_converter{ std::move(chain), std::forward<BaseIteratorArgT>(it) } }
+    {}
+
+    batched_push_converter(batched_push_converter&& rhs) noexcept
+    {
+        take(rhs);
+    }
+
+    batched_push_converter& operator=(batched_push_converter&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            destroy();
+            take(rhs);
+        }
+        return *this;
+    }
+
+    ~batched_push_converter() { destroy(); }
+
+    inline void push(ET elem)
+    {
+        batch_[batched_++] = elem;
+        if (batched_ == BatchV) drain();
+    }
+
+    void push(std::span<const ET> elems)
+    {
+        if (elems.size() <= BatchV - batched_) {
+            std::copy(elems.begin(), elems.end(), batch_.data() + batched_);
+            batched_ += elems.size();
+            if (batched_ == BatchV) drain();
+            return;
+        }
+        drain();
+        cvt_->push(elems);
+    }
+
+    template <size_t E>
+    void push(std::span<const ET, E> elems)
+    {
+        push(std::span{ elems.data(), elems.size() });
+    }
+
+    void flush()
+    {
+        drain();
+        cvt_->flush();
+    }
+
+    void finish()
+    {
+        drain();
+        cvt_->finish();
+    }
+
+    // drops the batched input too
+    void reset()
+    {
+        batched_ = 0;
+        cvt_->reset();
+    }
+
+    bool is_inline() const noexcept { return inline_; }
+
+private:
+    void drain()
+    {
+        if (batched_) {
+            cvt_->push(std::span<const ET>{ batch_.data(), batched_ });
+            batched_ = 0;
+        }
+    }
+
+    void take(batched_push_converter& rhs) noexcept
+    {
+        std::copy_n(rhs.batch_.data(), rhs.batched_, batch_.data());
+        batched_ = std::exchange(rhs.batched_, 0);
+        if (!rhs.cvt_) return;
+        if (rhs.inline_) {
+            cvt_ = rhs.cvt_->move_to(static_cast<void*>(storage_));
+            inline_ = true;
+            rhs.destroy();
+        } else {
+            cvt_ = std::exchange(rhs.cvt_, nullptr);
+            inline_ = false;
+        }
+    }
+
+    void destroy() noexcept
+    {
+        if (!cvt_) return;
+        if (inline_) {
+            cvt_->~erased_t();
+        } else {
+            delete cvt_;
+        }
+        cvt_ = nullptr;
+        inline_ = false;
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[InlineBytesV];
+    erased_t* cvt_ = nullptr;
+    bool inline_ = false;
+    size_t batched_ = 0;
+    std::array<ET, BatchV> batch_;
+};
+
+}
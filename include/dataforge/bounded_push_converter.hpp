@@ -0,0 +1,190 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "push_converter.hpp"
+
+namespace dataforge {
+
+struct push_result
+{
+    size_t consumed = 0;    // input elements taken
+    size_t produced = 0;    // output elements written
+};
+
+namespace bounded_push_detail {
+
+// the consumer: writes into the caller's buffer while it has room, and
+// keeps the rest for the next call
+template <typename ET>
+struct bounded_writer
+{
+    ET* pos = nullptr;
+    ET* end = nullptr;
+    std::vector<ET> pending;
+    size_t pending_pos = 0;
+
+    template <typename DataT>
+    void operator()(DataT const& data)
+    {
+        if constexpr (requires { data.size(); }) {
+            size_t const n = (std::min)(data.size(), static_cast<size_t>(end - pos));
+            pos = std::copy(data.begin(), data.begin() + n, pos);
+            pending.insert(pending.end(), data.begin() + n, data.end());
+        } else if (pos != end) {
+            *pos++ = static_cast<ET>(data);
+        } else {
+            pending.push_back(static_cast<ET>(data));
+        }
+    }
+
+    size_t pending_size() const noexcept { return pending.size() - pending_pos; }
+
+    void drain()
+    {
+        size_t const n = (std::min)(pending_size(), static_cast<size_t>(end - pos));
+        pos = std::copy_n(pending.begin() + pending_pos, n, pos);
+        pending_pos += n;
+        if (pending_pos == pending.size()) {
+            pending.clear();
+            pending_pos = 0;
+        }
+    }
+};
+
+}
+
+// A push converter that writes into buffers given with every call, like
+// zlib's next_out/avail_out: push(input, out) converts the input piece by
+// piece (input_piece elements) while out has room and reports how much input
+// it took and how much output it wrote. The output of the last piece that
+// didn't fit stays inside and goes out first on the next call, so the held
+// back output is bounded by the output one piece (or finish()) can produce.
+// For a stage that buffers, such as a compressor, that output may include
+// what earlier pieces left in the stage, up to its internal buffer.
+//     bounded_push_converter cvt{ int8 | deflated() | int8 | base64 };
+//     auto [consumed, produced] = cvt.push(data, socket_buffer);
+//     ...
+//     do { produced = cvt.finish(socket_buffer); ... } while (cvt.pending());
+template <typename CvtTupleT, typename InstrumentationT = no_instrumentation>
+class bounded_push_converter
+{
+public:
+    static constexpr size_t chain_size = std::tuple_size_v<CvtTupleT>;
+    using input_element_type = typename std::tuple_element_t<0, CvtTupleT>::input_element_type;
+    using output_element_type = std::remove_const_t<typename std::tuple_element_t<chain_size - 1, CvtTupleT>::output_element_type>;
+
+private:
+    using writer_t = bounded_push_detail::bounded_writer<output_element_type>;
+
+public:
+    template <typename ... Quarks>
+    explicit bounded_push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, size_t input_piece = 4096)
+        : cvt_{ chain, writer_t{} }
+        , input_piece_{ (std::max)(input_piece, size_t{ 1 }) }
+    {}
+
+    template <typename ... Quarks>
+    requires(InstrumentationPolicy<InstrumentationT>)
+    bounded_push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, InstrumentationT, size_t input_piece = 4096)
+        : bounded_push_converter{ chain, input_piece }
+    {}
+
+    template <typename InputT, typename OutputT, size_t OutputExtentV>
+    push_result push(InputT const& input, std::span<OutputT, OutputExtentV> out)
+    {
+        auto in = span_cast<const input_element_type>(std::span{ input });
+        auto& w = begin(out);
+        push_result result;
+        while (w.pos != w.end && !in.empty()) {
+            auto const piece = in.first((std::min)(input_piece_, in.size()));
+            cvt_.push(piece);
+            in = in.subspan(piece.size());
+            result.consumed += piece.size();
+        }
+        result.produced = end();
+        return result;
+    }
+
+    // finishes the chain on the first call; returns the output written, call
+    // again while pending() is not zero
+    template <typename OutputT, size_t OutputExtentV>
+    size_t finish(std::span<OutputT, OutputExtentV> out)
+    {
+        begin(out);
+        if (!finished_) {
+            cvt_.finish();
+            finished_ = true;
+        }
+        return end();
+    }
+
+    // output held back for the next call
+    size_t pending() const noexcept { return cvt_.consumer().pending_size(); }
+    bool finished() const noexcept { return finished_ && !pending(); }
+
+    void reset()
+    {
+        cvt_.reset();
+        auto& w = cvt_.consumer();
+        w.pending.clear();
+        w.pending_pos = 0;
+        finished_ = false;
+    }
+
+    pipeline_stats<chain_size> stats() const noexcept requires(InstrumentationT::enabled)
+    {
+        return cvt_.stats();
+    }
+
+private:
+    template <typename OutputT, size_t OutputExtentV>
+    writer_t& begin(std::span<OutputT, OutputExtentV> out)
+    {
+        auto const o = span_cast<output_element_type>(std::span<OutputT>{ out });
+        auto& w = cvt_.consumer();
+        w.pos = o.data();
+        w.end = o.data() + o.size();
+        w.drain();
+        begin_ = o.data();
+        return w;
+    }
+
+    size_t end() noexcept
+    {
+        auto& w = cvt_.consumer();
+        size_t const produced = static_cast<size_t>(w.pos - begin_);
+        w.pos = w.end = nullptr;
+        return produced;
+    }
+
+    push_converter<CvtTupleT, writer_t, InstrumentationT> cvt_;
+    size_t input_piece_;
+    output_element_type* begin_ = nullptr;
+    bool finished_ = false;
+};
+
+template <typename CvtTupleT, typename ... Quarks>
+bounded_push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&)->bounded_push_converter<CvtTupleT>;
+
+template <typename CvtTupleT, typename ... Quarks>
+bounded_push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, size_t)->bounded_push_converter<CvtTupleT>;
+
+template <typename CvtTupleT, typename ... Quarks, InstrumentationPolicy InstrumentationT>
+bounded_push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, InstrumentationT)->bounded_push_converter<CvtTupleT, InstrumentationT>;
+
+template <typename CvtTupleT, typename ... Quarks, InstrumentationPolicy InstrumentationT>
+bounded_push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, InstrumentationT, size_t)->bounded_push_converter<CvtTupleT, InstrumentationT>;
+
+}
@@ -0,0 +1,152 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "push_converter.hpp"
+
+namespace dataforge {
+
+// The output size of n input elements through a whole chain: a bound when
+// every stage reports exact_output_size() or max_output_size(), empty
+// otherwise.
+template <typename CvtTupleT>
+std::optional<size_t> chain_max_output_size(CvtTupleT const& stages, size_t n) noexcept
+{
+    std::optional<size_t> result = n;
+    auto compose = [&result](auto const& stage) {
+        if (!result) return;
+        if constexpr (requires { { stage.exact_output_size(size_t{}) } -> std::convertible_to<size_t>; }) {
+            result = stage.exact_output_size(*result);
+        } else if constexpr (requires { { stage.max_output_size(size_t{}) } -> std::convertible_to<size_t>; }) {
+            result = stage.max_output_size(*result);
+        } else {
+            result.reset();
+        }
+    };
+    std::apply([&compose](auto const& ... stage) { (compose(stage), ...); }, stages);
+    return result;
+}
+
+template <typename CvtTupleT, typename ... Quarks>
+std::optional<size_t> max_output_size(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, size_t n)
+{
+    cvt_tuple_wrapper<CvtTupleT> stages{ chain };
+    return chain_max_output_size(*stages, n);
+}
+
+namespace convert_detail {
+
+// the consumer writing into a fixed buffer
+template <typename ET>
+struct span_writer
+{
+    ET* pos;
+    ET* end;
+
+    template <typename DataT>
+    void operator()(DataT const& data)
+    {
+        if constexpr (requires { data.size(); }) {
+            if (data.size() > static_cast<size_t>(end - pos)) overflow();
+            pos = std::copy(data.begin(), data.end(), pos);
+        } else {
+            if (pos == end) overflow();
+            *pos++ = static_cast<ET>(data);
+        }
+    }
+
+    [[noreturn]] static void overflow()
+    {
+        throw std::runtime_error("the output doesn't fit in the buffer");
+    }
+};
+
+// the consumer writing into a container sized in advance; it grows the
+// container if a stage outputs more than its bound
+template <typename ContainerT>
+struct container_writer
+{
+    using value_type = typename ContainerT::value_type;
+
+    ContainerT& container;
+    size_t size = 0;
+
+    template <typename DataT>
+    void operator()(DataT const& data)
+    {
+        if constexpr (requires { data.size(); }) {
+            reserve(data.size());
+            std::copy(data.begin(), data.end(), container.data() + size);
+            size += data.size();
+        } else {
+            reserve(1);
+            container.data()[size++] = static_cast<value_type>(data);
+        }
+    }
+
+    void reserve(size_t n)
+    {
+        if (container.size() - size < n) {
+            container.resize((std::max)(2 * container.size(), size + n));
+        }
+    }
+};
+
+}
+
+// Converts a whole contiguous input at once and returns the output in a new
+// container, a std::vector of the output elements by default:
+//     auto b64 = convert<std::string>(int8 | base64, data);
+// When every stage of the chain reports its output size, the container is
+// allocated once to the bound and the stages write straight into it.
+template <typename ContainerT = void, typename CvtTupleT, typename ... Quarks, typename InputT>
+auto convert(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, InputT const& input)
+{
+    using input_element_type = typename std::tuple_element_t<0, CvtTupleT>::input_element_type;
+    using output_element_type = std::remove_const_t<typename std::tuple_element_t<std::tuple_size_v<CvtTupleT> - 1, CvtTupleT>::output_element_type>;
+    using result_t = std::conditional_t<std::is_void_v<ContainerT>, std::vector<output_element_type>, ContainerT>;
+    using writer_t = convert_detail::container_writer<result_t>;
+
+    auto const in = span_cast<const input_element_type>(std::span{ input });
+    result_t result;
+    push_converter<CvtTupleT, writer_t> cvt{ chain, writer_t{ result } };
+    if (auto const bound = chain_max_output_size(cvt.chain(), in.size())) {
+        result.resize(*bound);
+    }
+    cvt.push(in);
+    cvt.finish();
+    result.resize(cvt.consumer().size);
+    return result;
+}
+
+// Converts a whole contiguous input into the given buffer and returns the
+// written part of it; throws std::runtime_error if the output doesn't fit.
+// max_output_size(chain, input size) tells how large the buffer has to be.
+template <typename CvtTupleT, typename ... Quarks, typename InputT, typename OutputT, size_t OutputExtentV>
+std::span<OutputT> convert_into(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, InputT const& input, std::span<OutputT, OutputExtentV> output)
+{
+    using input_element_type = typename std::tuple_element_t<0, CvtTupleT>::input_element_type;
+    using output_element_type = std::remove_const_t<typename std::tuple_element_t<std::tuple_size_v<CvtTupleT> - 1, CvtTupleT>::output_element_type>;
+    using writer_t = convert_detail::span_writer<output_element_type>;
+
+    auto const out = span_cast<output_element_type>(std::span<OutputT>{ output });
+    push_converter<CvtTupleT, writer_t> cvt{ chain, writer_t{ out.data(), out.data() + out.size() } };
+    cvt.push(span_cast<const input_element_type>(std::span{ input }));
+    cvt.finish();
+    return output.first(static_cast<size_t>(cvt.consumer().pos - out.data()));
+}
+
+}
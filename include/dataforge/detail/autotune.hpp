@@ -0,0 +1,292 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cpu_features.hpp"
+
+#if DATAFORGE_TARGET_X86 && (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+#  include <cpuid.h>
+#endif
+
+namespace dataforge {
+
+// ---------------------------------------------------------------------------
+// Kernel autotuner (DATAFORGE_PROFILE_AUTO only, opt-in).
+//
+// When several backends of an algorithm are usable on the running CPU, the
+// tuner times each of them on a few representative input sizes at first use
+// and then dispatches every call to the winner of its size class. Results are
+// kept in a "wisdom" text file keyed by the CPU model and the enabled feature
+// set, so later processes on the same kind of machine skip the measurement;
+// one file can hold the results of several machine types.
+//
+// Tuning is off unless enabled, either by the environment
+//   DATAFORGE_AUTOTUNE=1          tune at first use, keep results in memory
+//   DATAFORGE_WISDOM=<path>       tune at first use, load/store <path>
+// or by dataforge::autotune() (dataforge/autotune.hpp) before the first hash.
+// With tuning off the dispatchers use the static preference order.
+// ---------------------------------------------------------------------------
+struct autotune_settings
+{
+    std::atomic<bool> enabled = false;
+    std::string wisdom_path;    // empty: do not persist; guarded by wisdom_mutex
+    std::mutex wisdom_mutex;
+    // the time source of the measurements; tests substitute a fake one
+    std::function<std::chrono::steady_clock::time_point()> now = &std::chrono::steady_clock::now;
+};
+
+inline autotune_settings& autotune_config()
+{
+    static autotune_settings settings;
+    static const bool from_environment = [] {
+#if defined(_MSC_VER)
+#   pragma warning(push)
+#   pragma warning(disable: 4996)
+#endif
+        const char* autotune = std::getenv("DATAFORGE_AUTOTUNE");
+        const char* wisdom = std::getenv("DATAFORGE_WISDOM");
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+        settings.enabled = (autotune && *autotune && std::string_view{ autotune } != "0") || (wisdom && *wisdom);
+        if (wisdom) settings.wisdom_path = wisdom;
+        return true;
+    }();
+    (void)from_environment;
+    return settings;
+}
+
+namespace autotune_detail {
+
+// the key wisdom entries are stored under: the CPU model and the features
+// the dispatchers may use (DATAFORGE_CPU_TIER changes the candidate set)
+inline std::string cpu_key()
+{
+    std::string model;
+#if DATAFORGE_TARGET_X86
+    unsigned int regs[12] = {};
+    bool has_brand = false;
+#   if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0x80000000);
+    if (static_cast<unsigned int>(r[0]) >= 0x80000004) {
+        for (int i = 0; i < 3; ++i) {
+            __cpuid(r, 0x80000002 + i);
+            std::copy(r, r + 4, regs + 4 * i);
+        }
+        has_brand = true;
+    }
+#   elif defined(__GNUC__) || defined(__clang__)
+    if (__get_cpuid_max(0x80000000, nullptr) >= 0x80000004) {
+        for (unsigned int i = 0; i < 3; ++i) {
+            __get_cpuid(0x80000002 + i, regs + 4 * i, regs + 4 * i + 1, regs + 4 * i + 2, regs + 4 * i + 3);
+        }
+        has_brand = true;
+    }
+#   endif
+    if (has_brand) {
+        model.assign(reinterpret_cast<const char*>(regs), sizeof(regs));
+        model.resize(model.find('\0') == std::string::npos ? model.size() : model.find('\0'));
+    }
+#elif DATAFORGE_TARGET_ARM && defined(__linux__)
+    std::ifstream midr{ "/sys/devices/system/cpu/cpu0/regs/identification/midr_el1" };
+    std::getline(midr, model);
+#endif
+    // the key is one tab-separated field
+    for (char& c : model) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    model.erase(0, model.find_first_not_of(' '));
+    model.erase(model.find_last_not_of(' ') + 1);
+    if (model.empty()) model = "unknown";
+
+    model += '/';
+    for (unsigned f = 0; f < static_cast<unsigned>(cpu_feature::count); ++f) {
+        model += cpu_has(static_cast<cpu_feature>(f)) ? '1' : '0';
+    }
+    return model;
+}
+
+inline std::vector<std::string> split(std::string const& line)
+{
+    std::vector<std::string> fields;
+    std::istringstream is{ line };
+    for (std::string field; std::getline(is, field, '\t');) fields.push_back(std::move(field));
+    return fields;
+}
+
+// wisdom line: <cpu key> \t <algorithm> \t <backend per size class>...
+inline std::vector<std::string> load_wisdom(std::string const& path, std::string const& key, std::string_view algorithm)
+{
+    std::ifstream is{ path };
+    for (std::string line; std::getline(is, line);) {
+        if (line.empty() || line[0] == '#') continue;
+        std::vector<std::string> fields = split(line);
+        if (fields.size() > 2 && fields[0] == key && fields[1] == algorithm) {
+            fields.erase(fields.begin(), fields.begin() + 2);
+            return fields;
+        }
+    }
+    return {};
+}
+
+inline void store_wisdom(std::string const& path, std::string const& key, std::string_view algorithm, std::vector<std::string_view> const& winners)
+{
+    std::vector<std::string> lines;
+    {
+        std::ifstream is{ path };
+        for (std::string line; std::getline(is, line);) {
+            std::vector<std::string> fields = split(line);
+            if (fields.size() > 1 && fields[0] == key && fields[1] == algorithm) continue;
+            lines.push_back(std::move(line));
+        }
+    }
+    if (lines.empty()) lines.emplace_back("# dataforge kernel wisdom: cpu\talgorithm\tbackend per input size class");
+    std::string entry = key + '\t' + std::string{ algorithm };
+    for (std::string_view w : winners) (entry += '\t') += w;
+    lines.push_back(std::move(entry));
+
+    // write a sibling file and rename it over, so a concurrent reader never
+    // sees a torn file; failures only lose the cache
+    std::string const tmp = path + ".tmp";
+    {
+        std::ofstream os{ tmp, std::ios::trunc };
+        for (std::string const& line : lines) os << line << '\n';
+        if (!os) return;
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        // Windows does not replace an existing file on rename
+        std::remove(path.c_str());
+        std::rename(tmp.c_str(), path.c_str());
+    }
+}
+
+}
+
+// A block function chosen per call by the number of blocks processed. The
+// size classes are represented by 1, 8 and 64 blocks and split at 4 and 32.
+template <typename FnT>
+class tuned_backend
+{
+public:
+    static constexpr size_t class_count = 3;
+    static constexpr size_t class_blocks[class_count] = { 1, 8, 64 };
+
+    // bench(fn, data, block_count) runs fn over block_count blocks of data;
+    // a per_size = false backend is tuned for one block and used for all sizes
+    template <typename BenchT>
+    tuned_backend(std::string_view algorithm, accel_backend<FnT> preferred, std::vector<accel_backend<FnT>> const& candidates,
+        size_t block_size, BenchT const& bench, bool per_size = true, autotune_settings& settings = autotune_config())
+    {
+        std::fill(std::begin(winners_), std::end(winners_), preferred);
+        if (settings.enabled && candidates.size() > 1) {
+            tune(algorithm, candidates, block_size, bench, per_size ? class_count : 1, settings);
+        }
+        describe();
+    }
+
+    accel_backend<FnT> const& operator()(size_t block_count) const noexcept
+    {
+        return winners_[block_count < 4 ? 0 : (block_count < 32 ? 1 : 2)];
+    }
+
+    // e.g. "sha-ni" or "scalar (1-3 blocks), sha-ni (4+ blocks)"
+    std::string_view name() const noexcept { return name_; }
+
+private:
+    template <typename BenchT>
+    void tune(std::string_view algorithm, std::vector<accel_backend<FnT>> const& candidates, size_t block_size, BenchT const& bench, size_t tuned_classes, autotune_settings& settings)
+    {
+        std::string const key = autotune_detail::cpu_key();
+        std::string wisdom_path;
+        {
+            std::lock_guard lock{ settings.wisdom_mutex };
+            wisdom_path = settings.wisdom_path;
+        }
+        if (!wisdom_path.empty()) {
+            std::lock_guard lock{ settings.wisdom_mutex };
+            std::vector<std::string> const stored = autotune_detail::load_wisdom(wisdom_path, key, algorithm);
+            if (stored.size() == class_count && std::all_of(stored.begin(), stored.end(), [&](std::string const& n) { return find(candidates, n); })) {
+                for (size_t c = 0; c < class_count; ++c) winners_[c] = *find(candidates, stored[c]);
+                return;
+            }
+        }
+
+        // every trial processes the same number of bytes; the best of several
+        // trials, interleaved over the candidates, filters out noise
+        constexpr size_t trial_blocks = 256, trial_count = 5;
+        std::vector<unsigned char> data(class_blocks[class_count - 1] * block_size, 0x5a);
+        for (size_t c = 0; c < tuned_classes; ++c) {
+            size_t const blocks = class_blocks[c];
+            std::vector<std::chrono::steady_clock::duration> best(candidates.size(), std::chrono::steady_clock::duration::max());
+            for (size_t t = 0; t < trial_count; ++t) {
+                for (size_t ci = 0; ci < candidates.size(); ++ci) {
+                    auto const start = settings.now();
+                    for (size_t r = 0; r < trial_blocks / blocks; ++r) bench(candidates[ci].fn, data.data(), blocks);
+                    best[ci] = (std::min)(best[ci], settings.now() - start);
+                }
+            }
+            winners_[c] = candidates[std::min_element(best.begin(), best.end()) - best.begin()];
+        }
+        std::fill(std::begin(winners_) + tuned_classes, std::end(winners_), winners_[tuned_classes - 1]);
+
+        if (!wisdom_path.empty()) {
+            std::vector<std::string_view> names;
+            for (auto const& w : winners_) names.push_back(w.name);
+            std::lock_guard lock{ settings.wisdom_mutex };
+            autotune_detail::store_wisdom(wisdom_path, key, algorithm, names);
+        }
+    }
+
+    static accel_backend<FnT> const* find(std::vector<accel_backend<FnT>> const& candidates, std::string_view name) noexcept
+    {
+        auto it = std::find_if(candidates.begin(), candidates.end(), [name](auto const& c) { return c.name == name; });
+        return it == candidates.end() ? nullptr : &*it;
+    }
+
+    void describe()
+    {
+        static constexpr std::string_view ranges[class_count] = { "1-3", "4-31", "32+" };
+        for (size_t c = 0; c < class_count;) {
+            size_t last = c;
+            while (last + 1 < class_count && winners_[last + 1].name == winners_[c].name) ++last;
+            if (c == 0 && last == class_count - 1) {
+                name_ = winners_[c].name;
+                return;
+            }
+            if (!name_.empty()) name_ += ", ";
+            std::string_view const from = ranges[c], to = ranges[last];
+            name_.append(winners_[c].name).append(" (");
+            name_.append(from.substr(0, from.find_first_of("-+")));
+            if (last == class_count - 1) {
+                name_ += '+';
+            } else {
+                name_.append("-").append(to.substr(to.find('-') + 1));
+            }
+            name_ += " blocks)";
+            c = last + 1;
+        }
+    }
+
+    accel_backend<FnT> winners_[class_count];
+    std::string name_;
+};
+
+}
@@ -40,6 +40,9 @@ public:
     inline void finish(ConsumerT) noexcept {}
 
     inline void reset() noexcept {}
+
+    static constexpr chunk_independence chunk_alignment() noexcept { return { 1, 2 }; }
+    static constexpr size_t exact_output_size(size_t n) noexcept { return 2 * n; }
 };
 
 template <IntegralBasedQuark<8> FromQuarkT, typename ToEHT>
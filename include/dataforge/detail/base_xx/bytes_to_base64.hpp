@@ -69,6 +69,9 @@ public:
             cons(std::span{ elems, 3 });
         }
     }
+
+    static constexpr chunk_independence chunk_alignment() noexcept { return { 3, 4 }; }
+    static constexpr size_t exact_output_size(size_t n) noexcept { return (n + 2) / 3 * 4; }
 };
 
 template <IntegralBasedQuark<8> FromQuarkT, typename ToEHT>
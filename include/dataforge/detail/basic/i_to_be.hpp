@@ -47,6 +47,9 @@ public:
     inline void finish(ConsumerT) noexcept {}
 
     inline void reset() noexcept {}
+
+    static constexpr chunk_independence chunk_alignment() noexcept { return { 1, ByteCountV }; }
+    static constexpr size_t exact_output_size(size_t n) noexcept { return n * ByteCountV; }
 };
 
 template <std::integral IT>
@@ -74,6 +77,9 @@ public:
 
     inline void reset() noexcept {}
 
+    static constexpr chunk_independence chunk_alignment() noexcept { return { 1, 1 }; }
+    static constexpr size_t exact_output_size(size_t n) noexcept { return n; }
+
     using input_element_type = IT;
     using output_element_type = IT;
 
@@ -0,0 +1,78 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../../push_converter.hpp"
+
+namespace dataforge {
+
+template <typename ... ChainsT>
+class tee_pusher : public generic_pusher<void>
+{
+    std::tuple<cvt_tuple_wrapper<typename ChainsT::cvt_tuple_type> ...> branches_;
+
+    template <typename ChainT>
+    using branch_input_t = typename std::tuple_element_t<0, typename ChainT::cvt_tuple_type>::input_element_type;
+
+public:
+    using input_element_type = branch_input_t<std::tuple_element_t<0, std::tuple<ChainsT ...>>>;
+    using output_element_type = void; // tagged fragments of the branches
+
+    static_assert((std::is_same_v<branch_input_t<ChainsT>, input_element_type> && ...), "the branches of a tee must take the same input elements");
+
+    template <typename SrcT>
+    tee_pusher(SrcT const&, tee_qrk<ChainsT ...> const& t)
+        : branches_{ t.chains }
+    {}
+
+    // the input is pushed through all the branches while it is in the cache
+    template <typename DataT, typename ConsumerT>
+    void push(DataT const& data, ConsumerT cons)
+    {
+        for_each_branch(cons, [&data](auto&& branch) { branch(data); });
+    }
+
+    template <typename ConsumerT>
+    void flush(ConsumerT cons)
+    {
+        for_each_branch(cons, [](auto&& branch) { branch.flush(); });
+    }
+
+    template <typename ConsumerT>
+    void finish(ConsumerT cons)
+    {
+        for_each_branch(cons, [](auto&& branch) { branch.finish(); });
+    }
+
+    void reset()
+    {
+        auto none = [](auto&&) {};
+        for_each_branch(none, [](auto&& branch) { slice_push_converter{ branch }.reset(); });
+    }
+
+private:
+    template <typename ConsumerT, typename FnT>
+    void for_each_branch(ConsumerT& cons, FnT fn)
+    {
+        [&]<size_t ... I>(std::index_sequence<I ...>) {
+            (fn(tagged_converter{ *std::get<I>(branches_), std::integral_constant<size_t, I>{}, cons }), ...);
+        }(std::index_sequence_for<ChainsT ...>{});
+    }
+};
+
+template <typename SrcT, typename ... ChainsT>
+struct cvt_resolver<SrcT, tee_qrk<ChainsT ...>>
+{
+    using type = tee_pusher<ChainsT ...>;
+};
+
+}
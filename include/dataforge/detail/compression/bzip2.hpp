@@ -50,6 +50,7 @@ struct state
 private:
     explicit state(unsigned int bufsz)
         : buffer_size{ bufsz }
+        , ret{ BZ_OK }
     {
         strm_.bzalloc = nullptr;
         strm_.bzfree = nullptr;
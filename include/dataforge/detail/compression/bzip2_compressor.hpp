@@ -97,6 +97,9 @@ public:
         }
     }
 
+    // the bound libbzip2 documents for a compressed stream
+    static constexpr size_t max_output_size(size_t n) noexcept { return n + n / 100 + 600; }
+
     inline void reset() noexcept { }
 
     using input_element_type = unsigned char;
@@ -107,10 +110,12 @@ public:
     {
         for (;;) {
             if (input.empty()) {
+                // bzlib rejects BZ_FINISH once the stream has ended
+                if (state_->ret == BZ_STREAM_END) return {};
                 input = span_cast<const unsigned char>(p());
                 if (input.empty()) {
-                    if (int ret = BZ2_bzCompress(&state_->strm_, BZ_FINISH); ret < 0) {
-                        on_error("bzip2 compressor error", ret, *this);
+                    if (state_->ret = BZ2_bzCompress(&state_->strm_, BZ_FINISH); state_->ret < 0) {
+                        on_error("bzip2 compressor error", state_->ret, *this);
                     }
                     auto us = state_->used_span();
                     state_->reset_buffer();
@@ -97,7 +97,20 @@ public:
         }
     }
 
-    inline void reset() noexcept { state_->ret = Z_OK; }
+    // deflateBound() covers the input given to a single deflate() call; the
+    // input pushed in pieces may end blocks earlier, so every 16 KiB of it is
+    // given the room of one more stored block header (5 bytes)
+    size_t max_output_size(size_t n) const noexcept
+    {
+        return deflateBound(&state_->strm_, static_cast<uLong>(n)) + 5 * (n / 16384 + 1);
+    }
+
+    inline void reset() noexcept
+    {
+        deflateReset(&state_->strm_);
+        state_->reset_buffer();
+        state_->ret = Z_OK;
+    }
 
     using input_element_type = unsigned char;
     using output_element_type = unsigned char;
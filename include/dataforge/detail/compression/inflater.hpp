@@ -114,7 +114,12 @@ public:
         }
     }
 
-    inline void reset() noexcept { state_->ret = Z_OK; }
+    inline void reset() noexcept
+    {
+        inflateReset(&state_->strm_);
+        state_->reset_buffer();
+        state_->ret = Z_OK;
+    }
 
     using input_element_type = unsigned char;
     using output_element_type = unsigned char;
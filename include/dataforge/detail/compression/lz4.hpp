@@ -8,6 +8,7 @@
 #pragma once
 
 #include <new>
+#include <limits>
 #include <span>
 #include <cassert>
 
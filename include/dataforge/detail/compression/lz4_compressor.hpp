@@ -108,6 +108,12 @@ public:
         reset();
     }
 
+    size_t max_output_size(size_t n) const noexcept
+    {
+        // the frame header (LZ4F_HEADER_SIZE_MAX), the blocks and the end mark
+        return 19 + LZ4F_compressBound(n, &state_->prefs_);
+    }
+
     inline void reset()
     {
         state_->reset([this](const char* errstr, size_t r) { on_error(errstr, r, *this); });
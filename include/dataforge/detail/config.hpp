@@ -204,9 +204,15 @@
 #   define DATAFORGE_SHA_TARGET     __attribute__((target("sha,sse4.1")))
 #   define DATAFORGE_AVX512_TARGET  __attribute__((target("avx512f,avx512vl,sse4.1")))
 #   define DATAFORGE_SSE41_TARGET   __attribute__((target("sse4.1")))
+#   define DATAFORGE_SSE2_TARGET    __attribute__((target("sse2")))
+#   define DATAFORGE_SSSE3_TARGET   __attribute__((target("ssse3")))
+#   define DATAFORGE_AVX2_TARGET    __attribute__((target("avx2,bmi2")))
 #else
 #   define DATAFORGE_SHA_TARGET
 #   define DATAFORGE_AVX512_TARGET
 #   define DATAFORGE_SSE41_TARGET
+#   define DATAFORGE_SSE2_TARGET
+#   define DATAFORGE_SSSE3_TARGET
+#   define DATAFORGE_AVX2_TARGET
 #endif
 #endif
@@ -0,0 +1,236 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+
+#if DATAFORGE_TARGET_X86 && defined(_MSC_VER)
+#  include <intrin.h>
+#  include <immintrin.h>
+#endif
+#if DATAFORGE_TARGET_ARM && defined(__linux__)
+#  include <sys/auxv.h>
+#elif DATAFORGE_TARGET_ARM64 && defined(__APPLE__)
+#  include <sys/types.h>
+#  include <sys/sysctl.h>
+#endif
+
+namespace dataforge {
+
+// ---------------------------------------------------------------------------
+// Process-wide CPU feature registry.
+//
+// The CPU is probed once, on first use; every run-time (DATAFORGE_PROFILE_AUTO)
+// kernel dispatcher asks cpu_has() instead of probing on its own.
+//
+// The features are ordered into ISA tiers:
+//   x86:     scalar < sse4 (SSE2, SSSE3, SSE4.1) < sha (SHA-NI) < avx2 (AVX2 + BMI2)
+//            < avx512 (AVX-512F + VL)
+//   AArch64: scalar < neon < sha (SHA1, SHA2 crypto ext) < sha512 (ARMv8.2-A)
+// Setting the environment variable DATAFORGE_CPU_TIER to one of these names
+// hides every feature above that tier from the dispatchers, which lets one
+// binary be benchmarked tier by tier. Forced profiles never probe the CPU and
+// are not affected.
+// ---------------------------------------------------------------------------
+enum class cpu_feature : unsigned
+{
+    x86_sse2,
+    x86_ssse3,
+    x86_sse41,
+    x86_sha,        // SHA-NI (SHA-1 and SHA-256)
+    x86_avx2,       // AVX2 + BMI2, YMM state enabled by the OS
+    x86_avx512,     // AVX-512F + VL, ZMM state enabled by the OS
+    arm_neon,
+    arm_sha1,
+    arm_sha2,
+    arm_sha512,
+    count
+};
+
+namespace cpu_features_detail {
+
+struct feature_info
+{
+    std::string_view name;
+    unsigned tier;
+};
+
+inline constexpr feature_info features[] = {
+    { "sse2", 1 }, { "ssse3", 1 }, { "sse4.1", 1 }, { "sha", 2 }, { "avx2", 3 }, { "avx512", 4 },
+    { "neon", 1 }, { "sha1", 2 }, { "sha2", 2 }, { "sha512", 3 }
+};
+static_assert(std::size(features) == static_cast<size_t>(cpu_feature::count));
+
+#if DATAFORGE_TARGET_ARM
+inline constexpr std::string_view tiers[] = { "scalar", "neon", "sha", "sha512" };
+#else
+inline constexpr std::string_view tiers[] = { "scalar", "sse4", "sha", "avx2", "avx512" };
+#endif
+
+constexpr uint32_t bit(cpu_feature f) noexcept { return uint32_t{ 1 } << static_cast<unsigned>(f); }
+
+inline uint32_t probe() noexcept
+{
+    uint32_t result = 0;
+#if DATAFORGE_TARGET_X86
+#   if defined(_MSC_VER)
+    int regs[4] = { 0, 0, 0, 0 };
+    __cpuid(regs, 0);
+    int const max_leaf = regs[0];
+    __cpuid(regs, 1);
+    if (regs[3] & (1 << 26)) result |= bit(cpu_feature::x86_sse2);
+    if (regs[2] & (1 << 9)) result |= bit(cpu_feature::x86_ssse3);
+    if (regs[2] & (1 << 19)) result |= bit(cpu_feature::x86_sse41);
+    bool const osxsave = (regs[2] & (1 << 27)) != 0;
+    if (max_leaf >= 7) {
+        // XCR0 bits: 1 SSE, 2 AVX, 5 opmask, 6 ZMM_Hi256, 7 Hi16_ZMM
+        unsigned long long const xcr0 = osxsave ? _xgetbv(0) : 0;
+        __cpuidex(regs, 7, 0);
+        if (regs[1] & (1 << 29)) result |= bit(cpu_feature::x86_sha);
+        if ((xcr0 & 0x6ull) == 0x6ull && (regs[1] & (1 << 5)) && (regs[1] & (1 << 8))) {
+            result |= bit(cpu_feature::x86_avx2);
+        }
+        if ((xcr0 & 0xE6ull) == 0xE6ull && (regs[1] & (1 << 16)) && (regs[1] & (1u << 31))) {
+            result |= bit(cpu_feature::x86_avx512);
+        }
+    }
+#   elif defined(__GNUC__) || defined(__clang__)
+    // __builtin_cpu_supports folds in the XGETBV / OS-enablement checks.
+    if (__builtin_cpu_supports("sse2")) result |= bit(cpu_feature::x86_sse2);
+    if (__builtin_cpu_supports("ssse3")) result |= bit(cpu_feature::x86_ssse3);
+    if (__builtin_cpu_supports("sse4.1")) result |= bit(cpu_feature::x86_sse41);
+    if (__builtin_cpu_supports("sha")) result |= bit(cpu_feature::x86_sha);
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2")) result |= bit(cpu_feature::x86_avx2);
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")) result |= bit(cpu_feature::x86_avx512);
+#   endif
+#elif DATAFORGE_TARGET_ARM64
+    result |= bit(cpu_feature::arm_neon);
+#   if defined(__linux__)
+    // AT_HWCAP bits: 2 SHA1, 3 SHA2, 21 SHA512
+    unsigned long const hwcap = getauxval(16 /* AT_HWCAP */);
+    if (hwcap & (1ul << 2)) result |= bit(cpu_feature::arm_sha1);
+    if (hwcap & (1ul << 3)) result |= bit(cpu_feature::arm_sha2);
+    if (hwcap & (1ul << 21)) result |= bit(cpu_feature::arm_sha512);
+#   else
+    // SHA1/SHA2 are part of the ARMv8.0 crypto extension every non-Linux
+    // AArch64 platform we target ships with.
+    result |= bit(cpu_feature::arm_sha1) | bit(cpu_feature::arm_sha2);
+#       if defined(__APPLE__)
+    int val = 0;
+    size_t sz = sizeof(val);
+    if (sysctlbyname("hw.optional.armv8_2_sha512", &val, &sz, nullptr, 0) == 0 && val != 0) {
+        result |= bit(cpu_feature::arm_sha512);
+    }
+#       endif
+#   endif
+#elif DATAFORGE_TARGET_ARM && defined(__linux__)
+    // AArch32: AT_HWCAP bit 12 NEON; AT_HWCAP2 bits 2 SHA1, 3 SHA2
+    if (getauxval(16 /* AT_HWCAP */) & (1ul << 12)) result |= bit(cpu_feature::arm_neon);
+    unsigned long const hwcap2 = getauxval(26 /* AT_HWCAP2 */);
+    if (hwcap2 & (1ul << 2)) result |= bit(cpu_feature::arm_sha1);
+    if (hwcap2 & (1ul << 3)) result |= bit(cpu_feature::arm_sha2);
+#elif DATAFORGE_TARGET_ARM
+    result |= bit(cpu_feature::arm_neon) | bit(cpu_feature::arm_sha1) | bit(cpu_feature::arm_sha2);
+#endif
+    return result;
+}
+
+}
+
+class cpu_feature_registry
+{
+public:
+    // Probes the CPU; features above tier_cap (a tier name, see above) are
+    // reported as detected but not enabled. An empty or unknown cap is ignored.
+    explicit cpu_feature_registry(std::string_view tier_cap = {}) noexcept
+        : detected_{ cpu_features_detail::probe() }
+    {
+        unsigned max_tier = ~0u;
+        for (unsigned t = 0; t < std::size(cpu_features_detail::tiers); ++t) {
+            if (cpu_features_detail::tiers[t] == tier_cap) {
+                max_tier = t;
+                tier_cap_ = cpu_features_detail::tiers[t];
+            }
+        }
+        for (unsigned f = 0; f < static_cast<unsigned>(cpu_feature::count); ++f) {
+            if (cpu_features_detail::features[f].tier <= max_tier) enabled_ |= detected_ & (uint32_t{ 1 } << f);
+        }
+    }
+
+    // The registry the dispatchers use, capped by DATAFORGE_CPU_TIER.
+    static cpu_feature_registry const& instance() noexcept
+    {
+        static const cpu_feature_registry registry{ environment_tier_cap() };
+        return registry;
+    }
+
+    bool has(cpu_feature f) const noexcept { return (enabled_ & cpu_features_detail::bit(f)) != 0; }
+    bool detected(cpu_feature f) const noexcept { return (detected_ & cpu_features_detail::bit(f)) != 0; }
+
+    // the applied tier cap, empty if none
+    std::string_view tier_cap() const noexcept { return tier_cap_; }
+
+    static std::string_view name(cpu_feature f) noexcept { return cpu_features_detail::features[static_cast<unsigned>(f)].name; }
+
+private:
+    static std::string_view environment_tier_cap() noexcept
+    {
+#if defined(_MSC_VER)
+#   pragma warning(suppress: 4996)
+#endif
+        const char* cap = std::getenv("DATAFORGE_CPU_TIER");
+        return cap ? std::string_view{ cap } : std::string_view{};
+    }
+
+    uint32_t detected_;
+    uint32_t enabled_ = 0;
+    std::string_view tier_cap_;
+};
+
+inline bool cpu_has(cpu_feature f) noexcept
+{
+    return cpu_feature_registry::instance().has(f);
+}
+
+// ---------------------------------------------------------------------------
+// Backend selection registry.
+//
+// Every accelerated algorithm has a select_*_backend() function returning the
+// block function to run with the name of its backend. The AUTO profile calls
+// it once and caches the result; the forced profiles call it inline, where it
+// folds into a direct call. Each algorithm registers a query of its backend
+// name, which backend_report() (dataforge/backend_report.hpp) collects.
+// ---------------------------------------------------------------------------
+template <typename FnT>
+struct accel_backend
+{
+    FnT fn;
+    std::string_view name;
+};
+
+using backend_name_query_t = std::string_view(*)();
+
+inline std::vector<std::pair<std::string_view, backend_name_query_t>>& backend_registry()
+{
+    static std::vector<std::pair<std::string_view, backend_name_query_t>> registry;
+    return registry;
+}
+
+inline bool register_backend(std::string_view algorithm, backend_name_query_t query)
+{
+    backend_registry().emplace_back(algorithm, query);
+    return true;
+}
+
+}
@@ -53,6 +53,7 @@ inline void belt_hash_impl::reset() noexcept
     h[1] = 0xe45d4a588e006d36ull;
     h[2] = 0xacc7b61b9dfa0485ull;
     h[3] = 0x0dcefd02c2722e25ull;
+    bit_count = 0;
 }
 
 void belt_hash_impl::sigma2(const uint_least64_t* x, uint_least64_t* result)
@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "md6.hpp"
+#include "digest_state.hpp"
 
 namespace dataforge {
 
@@ -76,6 +77,19 @@ public:
         finished = false;
     }
 
+    using state_type = digest_state<md6_state>;
+
+    state_type snapshot() const
+    {
+        return { state_ };
+    }
+
+    void restore(state_type const& st)
+    {
+        state_ = st.value;
+        finished = false;
+    }
+
 
     bool finished = false;
 
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "../quarks.hpp"
+#include "digest_state.hpp"
 
 namespace dataforge {
 
@@ -65,6 +66,19 @@ public:
         finished = 0;
     }
 
+    using state_type = digest_state<ImplT>;
+
+    state_type snapshot() const
+    {
+        return { static_cast<ImplT const&>(*this) };
+    }
+
+    void restore(state_type const& st)
+    {
+        ImplT::operator=(st.value);
+        finished = 0;
+    }
+
     size_t finished = 0;
     output_element_type cached;
 
@@ -0,0 +1,120 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <cassert>
+#include <type_traits>
+
+#include "../quarks.hpp"
+#include "../utility/data_ops.hpp"
+#include "digest_generic_pusher.hpp"
+
+namespace dataforge {
+
+template <typename ImplT, typename DigestQuarkT>
+inline ImplT make_digest_impl(DigestQuarkT const& dt)
+{
+    if constexpr (std::is_constructible_v<ImplT, DigestQuarkT const&>) {
+        return ImplT{ dt };
+    } else {
+        return ImplT{};
+    }
+}
+
+template <typename ImplT>
+inline size_t digest_block_length(ImplT const& impl) noexcept
+{
+    if constexpr (requires { { ImplT::block_size } -> std::convertible_to<size_t>; }) {
+        return ImplT::block_size;
+    } else {
+        return impl.block_length();
+    }
+}
+
+// Merkle-Damgard digests (declared by ImplT::merkle_damgard) finalize by
+// padding the buffered tail and compressing it, and the compression depends
+// on nothing but the chaining value. For them a message of a known length can
+// be padded once and each further message of that length costs one
+// process_blocks() call.
+template <typename ImplT>
+concept MerkleDamgardDigest = requires { requires ImplT::merkle_damgard; };
+
+// Writes the finalized digest of impl (digest_length() bytes) to dst.
+template <typename ImplT>
+inline void store_digest(ImplT& impl, unsigned char* dst)
+{
+    using word_type = typename ImplT::digest_word_type;
+    constexpr size_t word_byte_count = ImplT::digest_word_bit_count / 8;
+
+    auto const words = impl.digest_span();
+    size_t const length = impl.digest_length();
+    size_t i = 0;
+    if constexpr (word_byte_count == sizeof(word_type) && ImplT::digest_endianness() == std::endian::big) {
+        i = length / word_byte_count;
+        T_to_be(dst, words.data(), static_cast<int>(i));
+        i *= word_byte_count;
+    } else if constexpr (word_byte_count == sizeof(word_type) && ImplT::digest_endianness() == std::endian::native) {
+        i = length - length % word_byte_count;
+        std::memcpy(dst, words.data(), i);
+    }
+    for (; i < length; ++i) {
+        if constexpr (ImplT::digest_endianness() == std::endian::big) {
+            dst[i] = static_cast<unsigned char>(words[i / word_byte_count] >> (ImplT::digest_word_bit_count - 8 * (1 + i % word_byte_count)));
+        } else {
+            dst[i] = static_cast<unsigned char>(words[i / word_byte_count] >> (8 * (i % word_byte_count)));
+        }
+    }
+}
+
+template <typename ImplT>
+concept FixedLengthDigest = requires { typename std::integral_constant<size_t, ImplT::digest_length()>; };
+
+// Digest of exactly N more bytes on top of work, which has to be on a block
+// boundary (a fresh state or a midstate such as an HMAC pad state). The padded
+// tail is built directly on the stack and compressed by a single
+// process_blocks() call with a compile-time block count, bypassing the
+// buffering of input() and finalize(). data and dst may overlap.
+template <size_t N, MerkleDamgardDigest ImplT>
+inline void digest_fixed_into(ImplT& work, const void* data, unsigned char* dst)
+{
+    constexpr size_t block_count = (N + 1 + ImplT::input_length_size + ImplT::block_size - 1) / ImplT::block_size;
+    constexpr size_t tail_size = block_count * ImplT::block_size;
+
+    assert(!work.bytes_in_buf());
+    alignas(16) std::byte blocks[tail_size];
+    if constexpr (N > 0) std::memcpy(blocks, data, N);
+    blocks[N] = work.padding_byte;
+    std::memset(blocks + N + 1, 0, tail_size - N - 1);
+    work.count_bytes(N);
+    work.store_bit_count(blocks + tail_size - ImplT::input_length_size);
+    work.process_blocks(blocks, block_count);
+    store_digest(work, dst);
+}
+
+template <typename DigestPusherT> struct digest_impl_of;
+
+template <typename ImplT, typename ErrorHandlerT>
+struct digest_impl_of<digest_generic_pusher<ImplT, ErrorHandlerT>> { using type = ImplT; };
+
+// digest_fixed<64>(sha256, p): the digest of the 64 bytes at p.
+template <size_t N, typename DigestStartT, typename DigestFinishT>
+inline auto digest_fixed(compound_qrk<DigestStartT, DigestFinishT> const& digest, const void* data)
+{
+    using impl_t = typename digest_impl_of<typename cvt_resolver<int_qrk<8, void>, DigestStartT>::type>::type;
+    static_assert(MerkleDamgardDigest<impl_t> && FixedLengthDigest<impl_t>, "digest_fixed needs a fixed-length Merkle-Damgard digest");
+
+    std::array<unsigned char, impl_t::digest_length()> result;
+    impl_t work = make_digest_impl<impl_t>(digest.start);
+    digest_fixed_into<N>(work, data, result.data());
+    return result;
+}
+
+}
@@ -0,0 +1,68 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "../quarks.hpp"
+
+namespace dataforge {
+
+// The kind of converter a digest state was taken from. A plain digest and an
+// HMAC over it share the impl state type but not its meaning, so a snapshot
+// of one can't be restored into the other.
+struct plain_digest_kind {};
+struct hmac_digest_kind {};
+
+// A copy of a digest converter's working state: chaining values, the partial
+// block buffer and the length counter. Obtained from snapshot(), it can be
+// restored into any converter of the same digest and kind at any byte offset
+// (for an HMAC, one with the same key: the key isn't part of the type).
+template <typename StateT, typename KindT = plain_digest_kind>
+struct digest_state
+{
+    StateT value;
+};
+
+// Wraps a digest converter so that it starts from a saved midstate and returns
+// to it after every finish() / reset(): each message is hashed as if the
+// snapshotted prefix had been pushed before it.
+template <typename DigestPusherT>
+class midstate_pusher : public DigestPusherT
+{
+public:
+    using typename DigestPusherT::state_type;
+
+    template <IntegralBasedQuark<8> SrcTagT, typename MidstateQuarkT>
+    midstate_pusher(SrcTagT const& st, MidstateQuarkT const& dt)
+        : DigestPusherT{ st, dt.digest }
+        , initial_{ dt.state }
+    {
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(dt.state)>, state_type>, "the midstate was taken from a converter of another digest or kind");
+        DigestPusherT::restore(initial_);
+    }
+
+    template <typename ConsumerT>
+    void finish(ConsumerT&& cons)
+    {
+        DigestPusherT::finish(std::forward<ConsumerT>(cons));
+        DigestPusherT::restore(initial_);
+    }
+
+    void reset()
+    {
+        DigestPusherT::restore(initial_);
+    }
+
+private:
+    state_type initial_;
+};
+
+}
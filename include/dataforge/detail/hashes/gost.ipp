@@ -95,6 +95,7 @@ inline void gost_impl::reset() noexcept
     std::fill(sum.begin(), sum.end(), 0);
 	std::fill(hash.begin(), hash.end(), 0);
     l = r = 0;
+    bit_count = 0;
 }
 
 inline void gost_impl::gRound(uint_least32_t k1, uint_least32_t k2)
@@ -0,0 +1,116 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "digest_generic_pusher.hpp"
+#include "hmac_state.hpp"
+
+namespace dataforge {
+
+template <typename DigestPusherT> class hkdf_pusher;
+
+// HKDF (RFC 5869): the pushed bytes are the input keying material, which is
+// streamed straight into HMAC(salt, .) (extract); finish() expands the
+// pseudorandom key into the requested number of bytes.
+template <typename ImplT, typename ErrorHandlerT>
+class hkdf_pusher<digest_generic_pusher<ImplT, ErrorHandlerT>>
+{
+public:
+    using input_element_type = unsigned char;
+    using output_element_type = unsigned char;
+
+    template <IntegralBasedQuark<8> SrcTagT, typename HkdfQuarkT>
+    hkdf_pusher(SrcTagT const&, HkdfQuarkT const& dt)
+        : initial_{ make_digest_impl<ImplT>(dt.digest) }
+        , extract_{ initial_, dt.salt }
+        , work_{ extract_.inner }
+        , info_{ dt.info.begin(), dt.info.end() }
+        , key_(dt.length)
+    {
+        if (key_.empty()) throw std::runtime_error("hkdf: the output length must be positive");
+        if (key_.size() > 255 * extract_.digest_length()) throw std::runtime_error("hkdf: output too long");
+    }
+
+    template <CompatibleSpan<char> SpanT, typename ConsumerT>
+    inline void push(SpanT ivals, ConsumerT&&)
+    {
+        work_.input(ivals.data(), ivals.size());
+    }
+
+    template <Integral<8> LEIT, typename ConsumerT>
+    inline void push(const LEIT ival, ConsumerT&&)
+    {
+        work_.input(&ival, 1);
+    }
+
+    template <typename ConsumerT>
+    void finish(ConsumerT&& cons)
+    {
+        expand();
+        cons(std::span<const output_element_type>{ key_ });
+        reset();
+    }
+
+    void reset()
+    {
+        work_ = extract_.inner;
+        finished_ = false;
+    }
+
+    template <typename ProviderT>
+    std::span<const output_element_type> pull(std::span<const input_element_type>& input, ProviderT p)
+    {
+        if (finished_) return {};
+        if (input.empty()) {
+            input = span_cast<const input_element_type>(p());
+        }
+        while (!input.empty()) {
+            push(input, nullptr);
+            input = span_cast<const input_element_type>(p());
+        }
+        expand();
+        finished_ = true;
+        return key_;
+    }
+
+private:
+    // T(i) = HMAC(PRK, T(i - 1) || info || i), OKM = T(1) || T(2) || ...
+    void expand()
+    {
+        size_t const hlen = extract_.digest_length();
+        std::vector<unsigned char> t(hlen);
+        extract_.finish(work_, t.data());
+        hmac_state<ImplT> prf{ initial_, t };
+
+        size_t pos = 0;
+        for (unsigned char i = 1; pos < key_.size(); ++i) {
+            ImplT work = prf.inner;
+            if (i > 1) work.input(t.data(), hlen);
+            work.input(info_.data(), info_.size());
+            work.input(&i, 1);
+            prf.finish(work, t.data());
+            size_t const n = (std::min)(hlen, key_.size() - pos);
+            std::copy(t.begin(), t.begin() + n, key_.begin() + pos);
+            pos += n;
+        }
+        std::fill(t.begin(), t.end(), 0);
+    }
+
+    ImplT initial_;
+    hmac_state<ImplT> extract_;
+    ImplT work_;
+    std::vector<unsigned char> info_;
+    std::vector<output_element_type> key_;
+    bool finished_ = false;
+};
+
+}
@@ -0,0 +1,94 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#pragma once
+
+#include <vector>
+
+#include "digest_generic_pusher.hpp"
+#include "hmac_state.hpp"
+
+namespace dataforge {
+
+template <typename DigestPusherT> class hmac_pusher;
+
+// HMAC (RFC 2104) over any digest_generic_pusher based hash.
+// The key pads are absorbed once at construction; the resulting inner and
+// outer midstates are kept as plain copies of the digest state and restored
+// by assignment, so each message costs only its own blocks plus one outer
+// block (two for digests longer than the remaining space of the outer block).
+template <typename ImplT, typename ErrorHandlerT>
+class hmac_pusher<digest_generic_pusher<ImplT, ErrorHandlerT>>
+    : public digest_generic_pusher<ImplT, ErrorHandlerT>
+{
+    using base_t = digest_generic_pusher<ImplT, ErrorHandlerT>;
+
+public:
+    using typename base_t::input_element_type;
+    using typename base_t::output_element_type;
+
+    template <IntegralBasedQuark<8> SrcTagT, typename HmacQuarkT>
+    hmac_pusher(SrcTagT const& st, HmacQuarkT const& dt)
+        : base_t{ st, dt.digest }
+        , pads_{ static_cast<ImplT const&>(*this), dt.key }
+        , mac_(pads_.digest_length())
+    {
+        ImplT::operator=(pads_.inner);
+    }
+
+    using base_t::push;
+
+    template <typename ConsumerT>
+    void finish(ConsumerT&& cons)
+    {
+        pads_.finish(*this, mac_.data());
+        cons(std::span<const output_element_type>{ mac_ });
+        reset();
+    }
+
+    void reset()
+    {
+        ImplT::operator=(pads_.inner);
+        base_t::finished = 0;
+    }
+
+    using state_type = digest_state<ImplT, hmac_digest_kind>;
+
+    state_type snapshot() const
+    {
+        return { static_cast<ImplT const&>(*this) };
+    }
+
+    void restore(state_type const& st)
+    {
+        ImplT::operator=(st.value);
+        base_t::finished = 0;
+    }
+
+    template <typename ProviderT>
+    std::span<const output_element_type> pull(std::span<const input_element_type>& input, ProviderT p)
+    {
+        if (base_t::finished) return {};
+        if (input.empty()) {
+            input = span_cast<const input_element_type>(p());
+        }
+        while (!input.empty()) {
+            push(input, nullptr);
+            input = span_cast<const input_element_type>(p());
+        }
+        pads_.finish(*this, mac_.data());
+        base_t::finished = mac_.size();
+        return mac_;
+    }
+
+private:
+    hmac_state<ImplT> pads_;
+    std::vector<output_element_type> mac_;
+};
+
+}
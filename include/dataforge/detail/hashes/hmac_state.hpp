@@ -0,0 +1,72 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "digest_ops.hpp"
+
+namespace dataforge {
+
+// The two HMAC midstates: the digest state after absorbing K ^ ipad and
+// after absorbing K ^ opad (RFC 2104).
+template <typename ImplT>
+struct hmac_state
+{
+    ImplT inner;
+    ImplT outer;
+
+    hmac_state(ImplT const& initial, cbyte_span_t key)
+        : inner{ initial }, outer{ initial }
+    {
+        std::vector<unsigned char> kpad(digest_block_length(initial), 0);
+        if (key.size() > kpad.size()) {
+            ImplT kdigest = initial;
+            kdigest.input(key.data(), key.size());
+            kdigest.finalize();
+            store_digest(kdigest, kpad.data());
+        } else {
+            std::copy(key.begin(), key.end(), kpad.begin());
+        }
+
+        for (unsigned char& c : kpad) c ^= 0x36;
+        inner.input(kpad.data(), kpad.size());
+        for (unsigned char& c : kpad) c ^= 0x36 ^ 0x5c;
+        outer.input(kpad.data(), kpad.size());
+        std::fill(kpad.begin(), kpad.end(), 0);
+    }
+
+    size_t digest_length() const noexcept { return inner.digest_length(); }
+
+    // HMAC(K, msg) into out; msg and out may overlap
+    void mac(const void* msg, size_t len, unsigned char* out) const
+    {
+        ImplT work = inner;
+        work.input(msg, len);
+        finish(work, out);
+    }
+
+    // completes a message absorbed into a copy of inner
+    void finish(ImplT& work, unsigned char* out) const
+    {
+        work.finalize();
+        store_digest(work, out);
+        work = outer;
+        if constexpr (MerkleDamgardDigest<ImplT> && FixedLengthDigest<ImplT>) {
+            digest_fixed_into<ImplT::digest_length()>(work, out, out);
+        } else {
+            work.input(out, work.digest_length());
+            work.finalize();
+            store_digest(work, out);
+        }
+    }
+};
+
+}
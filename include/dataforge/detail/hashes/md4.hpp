@@ -18,6 +18,7 @@ struct md4_impl : digest_base<md4_impl, 64>
     static constexpr int digest_length() { return 16; }
     static constexpr std::endian digest_endianness() { return std::endian::little; }
     static constexpr int input_length_size = 8;
+    static constexpr bool merkle_damgard = true;
 
     using element_type = uint_least8_t;
     using word_type = uint_least32_t;
@@ -18,6 +18,7 @@ struct md5_impl : digest_base<md5_impl, 64>
     static constexpr size_t digest_length() { return 16; }
     static constexpr std::endian digest_endianness() { return std::endian::little; }
     static constexpr size_t input_length_size = 8;
+    static constexpr bool merkle_damgard = true;
 
     using word_type = uint_least32_t;
     using digest_word_type = word_type;
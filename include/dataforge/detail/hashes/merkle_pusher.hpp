@@ -0,0 +1,280 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "../utility/worker_threads.hpp"
+#include "digest_ops.hpp"
+
+namespace dataforge {
+
+enum class merkle_output { root, leaves_and_root };
+
+template <typename DigestPusherT> class merkle_pusher;
+
+// Merkle tree over fixed-size chunks (the last one may be short), with the
+// domain separation of RFC 6962: a leaf is the digest of 0x00 followed by the
+// chunk, a node the digest of 0x01 followed by its children concatenated.
+// Every group of up to arity consecutive nodes of a level is hashed into a
+// node of the next level, except that a trailing group of a single node is
+// carried up unchanged; for arity 2 this is the RFC 6962 tree. The root of an
+// empty input is the digest of the empty string.
+//
+// The tree is built as a stream: each level keeps only its incomplete group,
+// and a chunk split across pushes is absorbed into a running leaf digest, so
+// the state is O(arity * log(n)) digests. The whole chunks of a pushed span
+// are hashed in place, split over up to one thread per hardware thread, with
+// at least min_worker_batch_size bytes (or one chunk) for each thread.
+template <typename ImplT, typename ErrorHandlerT>
+class merkle_pusher<digest_generic_pusher<ImplT, ErrorHandlerT>>
+{
+    static constexpr size_t min_worker_batch_size = 256 * 1024;
+    static constexpr size_t max_batch_chunk_count = 16 * 1024;
+    static constexpr unsigned char leaf_prefix = 0;
+    static constexpr unsigned char node_prefix = 1;
+
+public:
+    using input_element_type = unsigned char;
+    using output_element_type = unsigned char;
+
+    template <IntegralBasedQuark<8> SrcTagT, typename MerkleQuarkT>
+    merkle_pusher(SrcTagT const&, MerkleQuarkT const& dt)
+        : initial_{ make_digest_impl<ImplT>(dt.digest) }
+        , leaf_initial_{ initial_ }
+        , leaf_{ initial_ }
+        , chunk_size_{ dt.chunk_size }
+        , arity_{ dt.arity }
+        , emit_leaves_{ dt.output == merkle_output::leaves_and_root }
+    {
+        if (!chunk_size_) throw std::runtime_error("merkle: the chunk size must be positive");
+        if (arity_ < 2) throw std::runtime_error("merkle: the arity must be at least 2");
+        leaf_initial_.input(&leaf_prefix, 1);
+        leaf_ = leaf_initial_;
+        digest_length_ = initial_.digest_length();
+        worker_count_ = hardware_worker_count();
+        worker_chunk_count_ = (std::max)(min_worker_batch_size / chunk_size_, size_t{ 1 });
+        batch_chunk_count_ = (std::min)(worker_count_ * worker_chunk_count_, max_batch_chunk_count);
+        if (batch_chunk_count_ < 2) {
+            batch_chunk_count_ = worker_count_ = 1;
+        }
+        digests_.resize(batch_chunk_count_ * digest_length_);
+    }
+
+    template <CompatibleSpan<char> SpanT, typename ConsumerT>
+    void push(SpanT ivals, ConsumerT&& cons)
+    {
+        auto const* p = reinterpret_cast<const unsigned char*>(ivals.data());
+        size_t len = ivals.size();
+        while (len) {
+            size_t n;
+            if (fill_ || len < chunk_size_) {
+                n = (std::min)(len, chunk_size_ - fill_);
+                leaf_.input(p, n);
+                fill_ += n;
+                if (fill_ == chunk_size_) {
+                    flush_leaf(cons);
+                }
+            } else {
+                size_t const count = (std::min)(len / chunk_size_, batch_chunk_count_);
+                n = count * chunk_size_;
+                hash_chunks(p, count, cons);
+            }
+            p += n;
+            len -= n;
+        }
+    }
+
+    template <Integral<8> LEIT, typename ConsumerT>
+    inline void push(const LEIT ival, ConsumerT&& cons)
+    {
+        push(std::span{ &ival, 1 }, std::forward<ConsumerT>(cons));
+    }
+
+    template <typename ConsumerT>
+    void finish(ConsumerT&& cons)
+    {
+        if (fill_) {
+            flush_leaf(cons);
+        }
+        if (leaf_count_) {
+            close_tree();
+        } else {
+            ImplT work = initial_;
+            root_.resize(digest_length_);
+            hash_leaf(work, root_.data());
+        }
+        cons(std::span<const output_element_type>{ root_ });
+        reset();
+    }
+
+    void reset()
+    {
+        leaf_ = leaf_initial_;
+        fill_ = 0;
+        leaf_count_ = 0;
+        levels_.clear();
+        finished_ = false;
+    }
+
+    template <typename ProviderT>
+    std::span<const output_element_type> pull(std::span<const input_element_type>& input, ProviderT p)
+    {
+        if (finished_) return {};
+        pulled_.clear();
+        auto collector = [this](auto const& v) {
+            if constexpr (std::is_integral_v<std::remove_cvref_t<decltype(v)>>) {
+                pulled_.push_back(v);
+            } else {
+                pulled_.insert(pulled_.end(), v.begin(), v.end());
+            }
+        };
+        for (;;) {
+            if (input.empty()) {
+                input = span_cast<const input_element_type>(p());
+            }
+            if (input.empty()) {
+                finish(collector);
+                finished_ = true;
+                return pulled_;
+            }
+            push(input, collector);
+            input = {};
+            if (!pulled_.empty()) return pulled_;
+        }
+    }
+
+private:
+    void hash_leaf(ImplT& work, unsigned char* dst) const
+    {
+        work.finalize();
+        store_digest(work, dst);
+    }
+
+    // the chunk absorbed across pushes
+    template <typename ConsumerT>
+    void flush_leaf(ConsumerT& cons)
+    {
+        hash_leaf(leaf_, digests_.data());
+        leaf_ = leaf_initial_;
+        fill_ = 0;
+        add_leaves(1, cons);
+    }
+
+    // count whole chunks at p, hashed in place
+    template <typename ConsumerT>
+    void hash_chunks(const unsigned char* p, size_t count, ConsumerT& cons)
+    {
+        // a thread is started only for min_worker_batch_size of input or more
+        size_t const worker_count = (std::min)(worker_count_, (std::max)(count / worker_chunk_count_, size_t{ 1 }));
+        run_on_workers(worker_count, [this, p, count, worker_count](size_t wi) {
+            size_t const first = count * wi / worker_count, last = count * (wi + 1) / worker_count;
+            for (size_t li = first; li < last; ++li) {
+                ImplT work = leaf_initial_;
+                work.input(p + li * chunk_size_, chunk_size_);
+                hash_leaf(work, digests_.data() + li * digest_length_);
+            }
+        });
+        add_leaves(count, cons);
+    }
+
+    template <typename ConsumerT>
+    void add_leaves(size_t count, ConsumerT& cons)
+    {
+        leaf_count_ += count;
+        std::span<const output_element_type> leaves{ digests_.data(), count * digest_length_ };
+        for (size_t li = 0; li < count; ++li) {
+            add_node(0, leaves.subspan(li * digest_length_, digest_length_));
+        }
+        if (emit_leaves_) {
+            cons(leaves);
+        }
+    }
+
+    // a group is node_prefix followed by its nodes
+    size_t node_count(std::vector<unsigned char> const& group) const
+    {
+        return (group.size() - 1) / digest_length_;
+    }
+
+    void hash_group(std::vector<unsigned char> const& group, std::vector<unsigned char>& dst) const
+    {
+        ImplT work = initial_;
+        dst.resize(digest_length_);
+        if constexpr (MerkleDamgardDigest<ImplT> && FixedLengthDigest<ImplT>) {
+            if (group.size() == 1 + 2 * ImplT::digest_length()) {
+                digest_fixed_into<1 + 2 * ImplT::digest_length()>(work, group.data(), dst.data());
+                return;
+            }
+        }
+        work.input(group.data(), group.size());
+        hash_leaf(work, dst.data());
+    }
+
+    std::vector<unsigned char>& level_group(size_t level)
+    {
+        while (levels_.size() <= level) levels_.push_back({ node_prefix });
+        return levels_[level];
+    }
+
+    void add_node(size_t level, std::span<const unsigned char> node)
+    {
+        for (;; ++level) {
+            std::vector<unsigned char>& group = level_group(level);
+            group.insert(group.end(), node.begin(), node.end());
+            if (node_count(group) < arity_) return;
+            hash_group(group, parent_);
+            group.resize(1);
+            node = parent_;
+        }
+    }
+
+    // folds the incomplete groups of all levels up into the root
+    void close_tree()
+    {
+        bool carry = false;
+        for (size_t level = 0;; ++level) {
+            std::vector<unsigned char>& group = level_group(level);
+            if (carry) group.insert(group.end(), root_.begin(), root_.end());
+            bool const top = std::all_of(levels_.begin() + level + 1, levels_.end(), [](auto const& g) { return g.size() == 1; });
+            size_t const count = node_count(group);
+            if (count == 1) {
+                root_.assign(group.begin() + 1, group.end());
+                if (top) return;
+            } else if (count) {
+                hash_group(group, root_);
+            }
+            carry = count != 0;
+            group.resize(1);
+        }
+    }
+
+    ImplT initial_;
+    ImplT leaf_initial_;
+    ImplT leaf_;
+    size_t chunk_size_;
+    size_t arity_;
+    bool emit_leaves_;
+    size_t digest_length_;
+    size_t worker_count_;
+    size_t worker_chunk_count_;
+    size_t batch_chunk_count_;
+
+    size_t fill_ = 0;
+    size_t leaf_count_ = 0;
+    std::vector<unsigned char> digests_;
+    std::vector<std::vector<unsigned char>> levels_;
+    std::vector<unsigned char> parent_;
+    std::vector<unsigned char> root_;
+    std::vector<output_element_type> pulled_;
+    bool finished_ = false;
+};
+
+}
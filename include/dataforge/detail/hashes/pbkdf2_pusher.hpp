@@ -0,0 +1,181 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "../utility/worker_threads.hpp"
+#include "digest_generic_pusher.hpp"
+#include "hmac_state.hpp"
+
+namespace dataforge {
+
+namespace pbkdf2_detail {
+
+// T_index = U_1 ^ U_2 ^ ... ^ U_c, U_1 = PRF(P, S || INT(index)),
+// U_j = PRF(P, U_{j-1}) (RFC 8018, 5.2); t and u hold digest_length() bytes.
+template <typename ImplT>
+void derive_block(hmac_state<ImplT> const& prf, cbyte_span_t salt, uint32_t index, size_t iterations, unsigned char* t, unsigned char* u)
+{
+    size_t const hlen = prf.digest_length();
+    unsigned char const index_be[4] = {
+        static_cast<unsigned char>(index >> 24), static_cast<unsigned char>(index >> 16),
+        static_cast<unsigned char>(index >> 8), static_cast<unsigned char>(index)
+    };
+    ImplT work = prf.inner;
+    work.input(salt.data(), salt.size());
+    work.input(index_be, 4);
+    prf.finish(work, u);
+    std::copy(u, u + hlen, t);
+
+    if constexpr (MerkleDamgardDigest<ImplT>) {
+        // Every later message, inner (U_{j-1}) and outer (the inner digest),
+        // is one hLen-byte tail after a pad block, so both fit one padded
+        // block built once: only its first hLen bytes change per call.
+        if (hlen + 1 + ImplT::input_length_size <= ImplT::block_size) {
+            work = prf.inner;
+            work.input(u, hlen);
+            work.finalize();
+            alignas(16) std::byte block[ImplT::block_size];
+            std::copy(std::begin(work.buffer_), std::end(work.buffer_), block);
+            unsigned char* const head = reinterpret_cast<unsigned char*>(block);
+            for (size_t j = 1; j < iterations; ++j) {
+                std::copy(u, u + hlen, head);
+                work = prf.inner;
+                work.process_blocks(block, 1);
+                store_digest(work, head);
+                work = prf.outer;
+                work.process_blocks(block, 1);
+                store_digest(work, u);
+                for (size_t k = 0; k < hlen; ++k) t[k] ^= u[k];
+            }
+            return;
+        }
+    }
+    for (size_t j = 1; j < iterations; ++j) {
+        prf.mac(u, hlen, u);
+        for (size_t k = 0; k < hlen; ++k) t[k] ^= u[k];
+    }
+}
+
+// Output blocks are independent, so when several are requested they are
+// spread over hardware threads.
+template <typename ImplT>
+void derive(hmac_state<ImplT> const& prf, cbyte_span_t salt, size_t iterations, unsigned char* dst, size_t length)
+{
+    size_t const hlen = prf.digest_length();
+    size_t const block_count = (length + hlen - 1) / hlen;
+    size_t const worker_count = (std::min)(block_count, hardware_worker_count());
+    std::vector<unsigned char> scratch(2 * hlen * worker_count);
+
+    run_on_workers(worker_count, [&](size_t wi) {
+        unsigned char* t = scratch.data() + 2 * hlen * wi;
+        for (size_t bi = wi; bi < block_count; bi += worker_count) {
+            size_t const pos = bi * hlen;
+            size_t const n = (std::min)(hlen, length - pos);
+            if (n == hlen) {
+                derive_block(prf, salt, static_cast<uint32_t>(bi + 1), iterations, dst + pos, t);
+            } else {
+                derive_block(prf, salt, static_cast<uint32_t>(bi + 1), iterations, t + hlen, t);
+                std::copy(t + hlen, t + hlen + n, dst + pos);
+            }
+        }
+    });
+    std::fill(scratch.begin(), scratch.end(), 0);
+}
+
+}
+
+template <typename DigestPusherT> class pbkdf2_pusher;
+
+// PBKDF2-HMAC (RFC 8018): the pushed bytes are the password, finish() emits
+// the derived key. The password is buffered until finish() since the HMAC
+// key has to be known before the first block of the salt is hashed.
+template <typename ImplT, typename ErrorHandlerT>
+class pbkdf2_pusher<digest_generic_pusher<ImplT, ErrorHandlerT>>
+{
+public:
+    using input_element_type = unsigned char;
+    using output_element_type = unsigned char;
+
+    template <IntegralBasedQuark<8> SrcTagT, typename Pbkdf2QuarkT>
+    pbkdf2_pusher(SrcTagT const&, Pbkdf2QuarkT const& dt)
+        : initial_{ make_digest_impl<ImplT>(dt.digest) }
+        , salt_{ dt.salt.begin(), dt.salt.end() }
+        , iterations_{ dt.iterations }
+        , key_(dt.length)
+    {
+        if (!iterations_) throw std::runtime_error("pbkdf2: the iteration count must be positive");
+        if (key_.empty()) throw std::runtime_error("pbkdf2: the derived key length must be positive");
+        if ((key_.size() - 1) / initial_.digest_length() >= 0xffffffffull) {
+            throw std::runtime_error("pbkdf2: derived key too long");
+        }
+    }
+
+    template <CompatibleSpan<char> SpanT, typename ConsumerT>
+    inline void push(SpanT ivals, ConsumerT&&)
+    {
+        auto const* p = reinterpret_cast<const input_element_type*>(ivals.data());
+        password_.insert(password_.end(), p, p + ivals.size());
+    }
+
+    template <Integral<8> LEIT, typename ConsumerT>
+    inline void push(const LEIT ival, ConsumerT&&)
+    {
+        password_.push_back(static_cast<input_element_type>(ival));
+    }
+
+    template <typename ConsumerT>
+    void finish(ConsumerT&& cons)
+    {
+        derive();
+        cons(std::span<const output_element_type>{ key_ });
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(password_.begin(), password_.end(), 0);
+        password_.clear();
+        finished_ = false;
+    }
+
+    template <typename ProviderT>
+    std::span<const output_element_type> pull(std::span<const input_element_type>& input, ProviderT p)
+    {
+        if (finished_) return {};
+        if (input.empty()) {
+            input = span_cast<const input_element_type>(p());
+        }
+        while (!input.empty()) {
+            push(input, nullptr);
+            input = span_cast<const input_element_type>(p());
+        }
+        derive();
+        finished_ = true;
+        return key_;
+    }
+
+private:
+    void derive()
+    {
+        hmac_state<ImplT> prf{ initial_, password_ };
+        pbkdf2_detail::derive(prf, salt_, iterations_, key_.data(), key_.size());
+    }
+
+    ImplT initial_;
+    std::vector<unsigned char> salt_;
+    size_t iterations_;
+    std::vector<input_element_type> password_;
+    std::vector<output_element_type> key_;
+    bool finished_ = false;
+};
+
+}
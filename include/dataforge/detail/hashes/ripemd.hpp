@@ -77,6 +77,7 @@ struct ripemd_impl : ripemd_impl_base<Type>
     static constexpr size_t digest_word_bit_count = 32;
 
     static const int input_length_size = 8;
+    static constexpr bool merkle_damgard = true;
     static constexpr int digest_length() { return sizeof(ripemd_impl::init_values) / sizeof(ripemd_impl::word_type) * 4; }
     static constexpr std::endian digest_endianness() { return std::endian::little; }
 
@@ -141,6 +141,7 @@ template <ripemd_type Type>
 void ripemd_impl<Type>::reset()
 {
     std::memcpy(ripemd_impl::h, ripemd_impl::init_values, sizeof(ripemd_impl::init_values));
+    this->bit_count = 0;
 }
 
 inline void ripemd_impl_base<ripemd_type::ripemd128>::process_block(const void* msg)
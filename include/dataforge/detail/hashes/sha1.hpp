@@ -34,6 +34,7 @@ struct sha1_impl : digest_base<sha1_impl, 64>
     static constexpr size_t digest_length() { return 20; }
     static constexpr std::endian digest_endianness() { return std::endian::big; }
     static constexpr int input_length_size = 8;
+    static constexpr bool merkle_damgard = true;
 
     using word_type = uint_least32_t;
     using digest_word_type = word_type;
@@ -7,6 +7,8 @@
 ==============================================================================*/
 
 #include <cstring>
+#include "../cpu_features.hpp"
+#include "../autotune.hpp"
 
 #if DATAFORGE_ACCEL_CAN_COMPILE_X86_SHA1
 #   include "sha1_intrinsics_x86.ipp"
@@ -36,34 +38,56 @@ inline void sha1_impl::reset()
     bit_count = 0;
 }
 
-inline void sha1_impl::process_blocks(const void* msg, size_t block_count)
+using sha1_block_fn_t = void(*)(sha1_impl::word_type(&)[sha1_impl::state_size], const void*, size_t);
+
+inline accel_backend<sha1_block_fn_t> select_sha1_backend() noexcept
 {
 #if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
-    using sha1_block_fn_t = void(*)(word_type(&)[state_size], const void*, size_t);
-    static const sha1_block_fn_t process_blocks_impl = []() -> sha1_block_fn_t {
 #   if DATAFORGE_TARGET_X86 && DATAFORGE_ACCEL_CAN_COMPILE_X86_SHA1
-        if (sha1_runtime_has_sha1_accel())
-            return process_blocks_sha1_x86;
-        return &sha1_impl::process_blocks_scalar;
+    if (cpu_has(cpu_feature::x86_sha))
+        return { &process_blocks_sha1_x86, "sha-ni" };
 #   elif DATAFORGE_TARGET_ARM && DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA1
-        if (sha1_runtime_has_sha1_accel())
-            return &process_blocks_sha1_arm;
-        return &sha1_impl::process_blocks_scalar;
-#   else
-        return &sha1_impl::process_blocks_scalar;
+    if (cpu_has(cpu_feature::arm_sha1))
+        return { &process_blocks_sha1_arm, "armv8-sha1" };
 #   endif
-    }();
-    process_blocks_impl(H, msg, block_count);
 #elif DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_X86
-    process_blocks_sha1_x86(H, msg, block_count);
+    return { &process_blocks_sha1_x86, "sha-ni" };
 #elif DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_ARM
 #   if DATAFORGE_ACCEL_ARM_USE_CRYPTO && DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA1
-    process_blocks_sha1_arm(H, msg, block_count);
-#   else
-    process_blocks_scalar(H, msg, block_count);
+    return { &process_blocks_sha1_arm, "armv8-sha1" };
 #   endif
-#else // DATAFORGE_ACCEL_NONE
-    process_blocks_scalar(H, msg, block_count);
+#endif
+    return { &sha1_impl::process_blocks_scalar, "scalar" };
+}
+
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
+inline std::vector<accel_backend<sha1_block_fn_t>> sha1_backend_candidates()
+{
+    std::vector<accel_backend<sha1_block_fn_t>> result;
+    if (auto preferred = select_sha1_backend(); preferred.fn != &sha1_impl::process_blocks_scalar) result.push_back(preferred);
+    result.push_back({ &sha1_impl::process_blocks_scalar, "scalar" });
+    return result;
+}
+
+inline tuned_backend<sha1_block_fn_t> const& sha1_backend()
+{
+    static const tuned_backend<sha1_block_fn_t> backend{ "sha1", select_sha1_backend(), sha1_backend_candidates(), 64,
+        [](sha1_block_fn_t fn, const void* data, size_t block_count) { sha1_impl::word_type state[sha1_impl::state_size] = {}; fn(state, data, block_count); } };
+    return backend;
+}
+
+inline const bool sha1_backend_registered = register_backend("sha1", [] { return sha1_backend().name(); });
+#else
+inline const bool sha1_backend_registered = register_backend("sha1", [] { return select_sha1_backend().name; });
+#endif
+
+inline void sha1_impl::process_blocks(const void* msg, size_t block_count)
+{
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
+    static const auto& backend = sha1_backend();
+    backend(block_count).fn(H, msg, block_count);
+#else
+    select_sha1_backend().fn(H, msg, block_count);
 #endif
 }
 
@@ -16,30 +16,8 @@
 
 #include <arm_neon.h>
 
-#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE && defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
-#include <sys/auxv.h>
-#include <asm/hwcap.h>
-#endif
-
 namespace dataforge::sha1_detail {
 
-#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
-inline bool sha1_runtime_has_sha1_accel()
-{
-#if defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
-#ifndef HWCAP_SHA1
-#define HWCAP_SHA1 (1UL << 2)
-#endif
-#ifndef AT_HWCAP
-#define AT_HWCAP 16
-#endif
-    return (getauxval(AT_HWCAP) & HWCAP_SHA1) != 0;
-#else
-    return true;
-#endif
-}
-#endif // DATAFORGE_ACCEL_AUTODETECT_MODE
-
 // --------------------------------------------------------------------------
 // SHA-1 ARMv8 Crypto Extension backend.
 //
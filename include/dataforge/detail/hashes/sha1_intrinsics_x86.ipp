@@ -10,28 +10,8 @@
 
 #include <immintrin.h>
 
-#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE && defined(_MSC_VER)
-#include <intrin.h>
-#endif
-
 namespace dataforge::sha1_detail {
 
-#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
-// CPUID leaf 7, EBX bit 29 -> Intel SHA Extensions (SHA-1 and SHA-256).
-inline bool sha1_runtime_has_sha1_accel()
-{
-#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
-    int regs[4] = { 0, 0, 0, 0 };
-    __cpuidex(regs, 7, 0);
-    return (regs[1] & (1 << 29)) != 0;
-#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
-    return __builtin_cpu_supports("sha");
-#else
-    return true;
-#endif
-}
-#endif // DATAFORGE_ACCEL_AUTODETECT_MODE
-
 // --------------------------------------------------------------------------
 // SHA-1 SHA-NI backend — canonical Intel Application Note pattern.
 //
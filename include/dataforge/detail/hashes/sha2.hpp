@@ -160,6 +160,7 @@ template <sha2_type Type>
 struct sha2_impl : sha2_impl_base<Type>
 {
     static constexpr std::endian digest_endianness() { return std::endian::big; }
+    static constexpr bool merkle_damgard = true;
     using word_type = typename sha2_impl_base<Type>::word_type;
     static constexpr size_t word_bit_count = sha2_impl_base<Type>::word_type_byte_count * 8;
 
@@ -8,6 +8,8 @@
 
 #include <algorithm>
 #include "../utility/data_ops.hpp"
+#include "../cpu_features.hpp"
+#include "../autotune.hpp"
 
 #if DATAFORGE_ACCEL_CAN_COMPILE_X86_SHA
 #   include "sha2_intrinsics_x86.ipp"
@@ -24,19 +26,6 @@
 #   include "sha512_neon_arm.ipp"
 #endif
 
-#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
-namespace dataforge::sha2_detail {
-    inline bool sha256_runtime_has_sha256_accel();
-#if DATAFORGE_TARGET_X86 && DATAFORGE_ACCEL_CAN_COMPILE_X86_AVX512
-    inline bool x86_runtime_has_sse41();
-    inline bool x86_runtime_has_avx512();
-#endif
-#if DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA512
-    inline bool sha512_runtime_has_sha512_accel();
-#endif
-}
-#endif
-
 namespace dataforge::sha2_detail {
 
 alignas(64) inline const sha2_def_base<256>::word_type sha2_def_base<256>::K[64] = {
@@ -244,124 +233,182 @@ void sha2_impl<Type>::store_bit_count(void* dst) const
     this->bit_count.store_as_big_endian(dst, sizeof(word_type) < 8 ? 1 : 2);
 }
 
-template<sha2_type Type>
-inline void sha2_impl<Type>::process_blocks(const void* msg, size_t block_count)
+// SHA-224/SHA-256 (32-bit words). SHA-NI is the default hardware path; the
+// AVX-512 schedule is used only with DATAFORGE_PROFILE_X86_AVX512 (SHA-NI is
+// faster per block, so AVX-512 here is never auto-selected).
+using sha256_block_fn_t = void(*)(uint32_t(&)[8], const void*, size_t);
+
+inline accel_backend<sha256_block_fn_t> select_sha256_backend() noexcept
 {
-    if constexpr (Type == sha2_type::sha224 || Type == sha2_type::sha256)
-    {
-        // SHA-224/SHA-256 (32-bit words). SHA-NI is the default hardware path;
-        // the AVX-512 schedule is used only with DATAFORGE_PROFILE_X86_AVX512
-        // (SHA-NI is faster per block, so AVX-512 here is never auto-selected).
 #if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
-        // Probe the running CPU once and cache the best available block function.
-        using sha256_block_fn_t = void(*)(uint32_t(&)[8], const void*, size_t);
-        static const sha256_block_fn_t process_blocks_impl = []() -> sha256_block_fn_t {
 #   if DATAFORGE_TARGET_X86 && DATAFORGE_ACCEL_CAN_COMPILE_X86_SHA
 #       if DATAFORGE_ACCEL_X86_USE_AVX512
-            if (x86_runtime_has_avx512())
-                return &process_blocks_sha256_x86_avx512;
+    if (cpu_has(cpu_feature::x86_avx512))
+        return { &process_blocks_sha256_x86_avx512, "avx512" };
 #       endif
-            if (sha256_runtime_has_sha256_accel())
-                return &process_blocks_sha256_x86;
-            return &sha2_impl<Type>::process_blocks_scalar;
+    if (cpu_has(cpu_feature::x86_sha))
+        return { &process_blocks_sha256_x86, "sha-ni" };
 #   elif DATAFORGE_TARGET_ARM && DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA2
-            if (sha256_runtime_has_sha256_accel())
-                return &process_blocks_sha256_arm;
-            return &sha2_impl<Type>::process_blocks_scalar;
-#   else
-            return &sha2_impl<Type>::process_blocks_scalar;
+    if (cpu_has(cpu_feature::arm_sha2))
+        return { &process_blocks_sha256_arm, "armv8-sha2" };
 #   endif
-        }();
-        process_blocks_impl(H, msg, block_count);
 
 #elif DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_X86
-        // Forced x86 backend: emit the intrinsic implementation directly, with no
-        // run-time CPU probing (the caller asserts the CPU supports it). We still
-        // only emit code the *compilation target* can encode — that compile-time
-        // guarantee is what DATAFORGE_ACCEL_CAN_COMPILE_X86_SHA reflects, and a
-        // forced-x86 build on a non-x86 target is downgraded to scalar in sha2.hpp.
-        // AVX-512 path is taken when the X86_AVX512 profile is active and the
-        // compiler can emit AVX-512 (via per-function target attributes on GCC/Clang,
-        // or globally with /arch:AVX512 on MSVC). Do NOT use __AVX512F__ here —
-        // that macro is only defined when the whole TU is compiled with AVX-512 flags,
-        // but the AVX-512 functions are self-contained via DATAFORGE_AVX512_TARGET.
+    // Forced x86 backend: the intrinsic implementation with no run-time CPU
+    // probing (the caller asserts the CPU supports it). We still only emit code
+    // the *compilation target* can encode — that compile-time guarantee is what
+    // DATAFORGE_ACCEL_CAN_COMPILE_X86_SHA reflects, and a forced-x86 build on a
+    // non-x86 target is downgraded to scalar in sha2.hpp.
+    // AVX-512 path is taken when the X86_AVX512 profile is active and the
+    // compiler can emit AVX-512 (via per-function target attributes on GCC/Clang,
+    // or globally with /arch:AVX512 on MSVC). Do NOT use __AVX512F__ here —
+    // that macro is only defined when the whole TU is compiled with AVX-512 flags,
+    // but the AVX-512 functions are self-contained via DATAFORGE_AVX512_TARGET.
 #   if DATAFORGE_ACCEL_X86_USE_AVX512 && DATAFORGE_ACCEL_CAN_COMPILE_X86_AVX512
-        process_blocks_sha256_x86_avx512(H, msg, block_count);
+    return { &process_blocks_sha256_x86_avx512, "avx512" };
 #   else
-        process_blocks_sha256_x86(H, msg, block_count);
+    return { &process_blocks_sha256_x86, "sha-ni" };
 #   endif
 
 #elif DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_ARM
 #   if DATAFORGE_ACCEL_ARM_USE_CRYPTO && DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA2
-        process_blocks_sha256_arm(H, msg, block_count);
-#   else
-        process_blocks_scalar(H, msg, block_count);
+    return { &process_blocks_sha256_arm, "armv8-sha2" };
 #   endif
-
-#else // DATAFORGE_ACCEL_NONE
-        process_blocks_scalar(H, msg, block_count);
 #endif
-    }
-    else
-    {
-        // SHA-384 / SHA-512 / SHA-512-224 / SHA-512-256 (64-bit words). There is
-        // no SHA-NI equivalent for these, but the AVX-512 vectorized message
-        // schedule beats scalar, so it is used by default in auto-detect whenever
-        // the CPU supports AVX-512.
+    return { &sha2_impl<sha2_type::sha256>::process_blocks_scalar, "scalar" };
+}
+
+// SHA-384 / SHA-512 / SHA-512-224 / SHA-512-256 (64-bit words). There is no
+// SHA-NI equivalent for these, but the vectorized message schedules beat
+// scalar, so auto-detect picks the widest one the CPU supports:
+// AVX-512 -> AVX2 (two blocks per schedule pass) -> SSSE3.
+using sha512_block_fn_t = void(*)(uint64_t(&)[8], const void*, size_t);
+
+inline accel_backend<sha512_block_fn_t> select_sha512_backend() noexcept
+{
 #if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
-#if DATAFORGE_TARGET_X86 && DATAFORGE_ACCEL_CAN_COMPILE_X86_AVX512
-        using sha512_block_fn_t = void(*)(uint64_t(&)[8], const void*, size_t);
-        static const sha512_block_fn_t process_blocks_impl = []() -> sha512_block_fn_t {
-            if (x86_runtime_has_avx512())
-                return &process_blocks_sha512_x86_avx512;
-            if (x86_runtime_has_sse41())
-                return &process_blocks_sha512_x86_sse41;
-            return &sha2_impl<Type>::process_blocks_scalar;
-        }();
-        process_blocks_impl(H, msg, block_count);
-#elif DATAFORGE_TARGET_ARM && (DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA512 || DATAFORGE_ACCEL_CAN_COMPILE_ARM_NEON_SHA512)
-        using sha512_block_fn_t = void(*)(uint64_t(&)[8], const void*, size_t);
-        static const sha512_block_fn_t process_blocks_impl = []() -> sha512_block_fn_t {
-#   if DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA512
-            if (sha512_runtime_has_sha512_accel())
-                return &process_blocks_sha512_arm;
-#   endif
-#   if DATAFORGE_ACCEL_CAN_COMPILE_ARM_NEON_SHA512
-            return &process_blocks_sha512_arm_neon;
-#   else
-            return &sha2_impl<Type>::process_blocks_scalar;
+#   if DATAFORGE_TARGET_X86 && DATAFORGE_ACCEL_CAN_COMPILE_X86_AVX512
+    if (cpu_has(cpu_feature::x86_avx512))
+        return { &process_blocks_sha512_x86_avx512, "avx512" };
+    if (cpu_has(cpu_feature::x86_avx2))
+        return { &process_blocks_sha512_x86_avx2, "avx2" };
+    if (cpu_has(cpu_feature::x86_ssse3))
+        return { &process_blocks_sha512_x86_ssse3, "ssse3" };
+#   elif DATAFORGE_TARGET_ARM && (DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA512 || DATAFORGE_ACCEL_CAN_COMPILE_ARM_NEON_SHA512)
+#       if DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA512
+    if (cpu_has(cpu_feature::arm_sha512))
+        return { &process_blocks_sha512_arm, "armv8.2-sha512" };
+#       endif
+#       if DATAFORGE_ACCEL_CAN_COMPILE_ARM_NEON_SHA512
+    if (cpu_has(cpu_feature::arm_neon))
+        return { &process_blocks_sha512_arm_neon, "neon" };
+#       endif
 #   endif
-        }();
-        process_blocks_impl(H, msg, block_count);
-#else
-        process_blocks_scalar(H, msg, block_count);
-#endif
 
 #elif DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_X86
-        // Forced x86: pick the best statically-available ISA level.
-        // Use profile flags rather than compiler-global TU macros (__AVX512F__,
-        // __SSE4_1__) — intrinsic functions are self-contained via their
-        // DATAFORGE_*_TARGET attributes and compile correctly without global flags.
-        // Any x86 profile (X86_SHA_NI or X86_AVX512) implies at least SSE4.1.
-#if DATAFORGE_ACCEL_X86_USE_AVX512 && DATAFORGE_ACCEL_CAN_COMPILE_X86_AVX512
-        process_blocks_sha512_x86_avx512(H, msg, block_count);
-#else
-        process_blocks_sha512_x86_sse41(H, msg, block_count);
-#endif
+    // Forced x86: pick the best statically-available ISA level.
+    // Use profile flags rather than compiler-global TU macros (__AVX512F__,
+    // __SSE4_1__) — intrinsic functions are self-contained via their
+    // DATAFORGE_*_TARGET attributes and compile correctly without global flags.
+    // Any x86 profile (X86_SHA_NI or X86_AVX512) implies at least SSSE3; the
+    // X86_SHA_NI profile does not imply AVX2 (Goldmont/Tremont have SHA-NI
+    // but no AVX), so it stays on the SSSE3 schedule.
+#   if DATAFORGE_ACCEL_X86_USE_AVX512 && DATAFORGE_ACCEL_CAN_COMPILE_X86_AVX512
+    return { &process_blocks_sha512_x86_avx512, "avx512" };
+#   else
+    return { &process_blocks_sha512_x86_ssse3, "ssse3" };
+#   endif
 
 #elif DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_ARM
 #   if DATAFORGE_ACCEL_ARM_USE_SHA512_EXT && DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA512
-        process_blocks_sha512_arm(H, msg, block_count);
+    return { &process_blocks_sha512_arm, "armv8.2-sha512" };
 #   elif DATAFORGE_ACCEL_CAN_COMPILE_ARM_NEON_SHA512
-        process_blocks_sha512_arm_neon(H, msg, block_count);
-#   else
-        process_blocks_scalar(H, msg, block_count);
+    return { &process_blocks_sha512_arm_neon, "neon" };
+#   endif
+#endif
+    return { &sha2_impl<sha2_type::sha512>::process_blocks_scalar, "scalar" };
+}
+
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
+// Every backend the running CPU can execute, for the autotuner; unlike the
+// static preference above this includes the AVX-512 SHA-256 schedule.
+inline std::vector<accel_backend<sha256_block_fn_t>> sha256_backend_candidates()
+{
+    std::vector<accel_backend<sha256_block_fn_t>> result;
+#   if DATAFORGE_TARGET_X86 && DATAFORGE_ACCEL_CAN_COMPILE_X86_SHA
+    if (cpu_has(cpu_feature::x86_sha)) result.push_back({ &process_blocks_sha256_x86, "sha-ni" });
+#       if DATAFORGE_ACCEL_CAN_COMPILE_X86_AVX512
+    if (cpu_has(cpu_feature::x86_avx512)) result.push_back({ &process_blocks_sha256_x86_avx512, "avx512" });
+#       endif
+#   elif DATAFORGE_TARGET_ARM && DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA2
+    if (cpu_has(cpu_feature::arm_sha2)) result.push_back({ &process_blocks_sha256_arm, "armv8-sha2" });
 #   endif
+    result.push_back({ &sha2_impl<sha2_type::sha256>::process_blocks_scalar, "scalar" });
+    return result;
+}
 
-#else // NONE
-        process_blocks_scalar(H, msg, block_count);
+inline std::vector<accel_backend<sha512_block_fn_t>> sha512_backend_candidates()
+{
+    std::vector<accel_backend<sha512_block_fn_t>> result;
+#   if DATAFORGE_TARGET_X86 && DATAFORGE_ACCEL_CAN_COMPILE_X86_AVX512
+    if (cpu_has(cpu_feature::x86_avx512)) result.push_back({ &process_blocks_sha512_x86_avx512, "avx512" });
+    if (cpu_has(cpu_feature::x86_avx2)) result.push_back({ &process_blocks_sha512_x86_avx2, "avx2" });
+    if (cpu_has(cpu_feature::x86_ssse3)) result.push_back({ &process_blocks_sha512_x86_ssse3, "ssse3" });
+#   elif DATAFORGE_TARGET_ARM
+#       if DATAFORGE_ACCEL_CAN_COMPILE_ARM_SHA512
+    if (cpu_has(cpu_feature::arm_sha512)) result.push_back({ &process_blocks_sha512_arm, "armv8.2-sha512" });
+#       endif
+#       if DATAFORGE_ACCEL_CAN_COMPILE_ARM_NEON_SHA512
+    if (cpu_has(cpu_feature::arm_neon)) result.push_back({ &process_blocks_sha512_arm_neon, "neon" });
+#       endif
+#   endif
+    result.push_back({ &sha2_impl<sha2_type::sha512>::process_blocks_scalar, "scalar" });
+    return result;
+}
+
+inline tuned_backend<sha256_block_fn_t> const& sha256_backend()
+{
+    static const tuned_backend<sha256_block_fn_t> backend{ "sha224/256", select_sha256_backend(), sha256_backend_candidates(), 64,
+        [](sha256_block_fn_t fn, const void* data, size_t block_count) { uint32_t state[8] = {}; fn(state, data, block_count); } };
+    return backend;
+}
+
+inline tuned_backend<sha512_block_fn_t> const& sha512_backend()
+{
+    static const tuned_backend<sha512_block_fn_t> backend{ "sha384/512", select_sha512_backend(), sha512_backend_candidates(), 128,
+        [](sha512_block_fn_t fn, const void* data, size_t block_count) { uint64_t state[8] = {}; fn(state, data, block_count); } };
+    return backend;
+}
+
+inline const bool sha256_backend_registered = register_backend("sha224/256", [] { return sha256_backend().name(); });
+inline const bool sha512_backend_registered = register_backend("sha384/512", [] { return sha512_backend().name(); });
+#else
+inline const bool sha256_backend_registered = register_backend("sha224/256", [] { return select_sha256_backend().name; });
+inline const bool sha512_backend_registered = register_backend("sha384/512", [] { return select_sha512_backend().name; });
+#endif
+
+template<sha2_type Type>
+inline void sha2_impl<Type>::process_blocks(const void* msg, size_t block_count)
+{
+    if constexpr (Type == sha2_type::sha224 || Type == sha2_type::sha256)
+    {
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
+        // The backend is chosen once: by the CPU features, or by the autotuner
+        // per input size class.
+        static const auto& backend = sha256_backend();
+        backend(block_count).fn(H, msg, block_count);
+#else
+        select_sha256_backend().fn(H, msg, block_count);
+#endif
+    }
+    else
+    {
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
+        static const auto& backend = sha512_backend();
+        backend(block_count).fn(H, msg, block_count);
+#else
+        select_sha512_backend().fn(H, msg, block_count);
 #endif
     }
 }
-
 }
@@ -16,30 +16,8 @@
 
 #include <arm_neon.h>
 
-#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE && defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
-#include <sys/auxv.h>
-#include <asm/hwcap.h>
-#endif
-
 namespace dataforge::sha2_detail {
 
-#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
-inline bool sha256_runtime_has_sha256_accel()
-{
-#if defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
-#  ifndef HWCAP_SHA2
-#    define HWCAP_SHA2 (1UL << 3)
-#  endif
-#  ifndef AT_HWCAP
-#    define AT_HWCAP 16
-#  endif
-    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
-#else
-    return true; // SHA-256 is part of ARMv8.0 Crypto; assume present on non-Linux AArch64.
-#endif
-}
-#endif
-
 inline void process_blocks_sha256_arm(uint32_t(&state)[8], const void* msg, size_t block_count)
 {
     const auto* data = reinterpret_cast<const uint8_t*>(msg);
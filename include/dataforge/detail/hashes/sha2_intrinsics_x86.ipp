@@ -10,80 +10,11 @@
 
 #include <immintrin.h>
 
-#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
-#if defined(_MSC_VER)
-#include <intrin.h>
-#endif
-#endif
-
 #include <cstdint>
 #include <cstring>
 
 namespace dataforge::sha2_detail {
 
-#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
-// CPUID leaf 7, EBX bit 29 -> Intel SHA Extensions (SHA-NI).
-inline bool sha256_runtime_has_sha256_accel()
-{
-#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
-    int regs[4] = { 0, 0, 0, 0 };
-    __cpuidex(regs, 7, 0);
-    return (regs[1] & (1 << 29)) != 0;
-#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
-    return __builtin_cpu_supports("sha");
-#else
-    return true;
-#endif
-}
-
-// CPUID leaf 1, ECX bit 19 -> SSE4.1. Used by the SHA-512 SSE4.1 backend
-// which is selected on x86-64 CPUs that lack AVX-512 (e.g. Raptor Lake desktop).
-inline bool x86_runtime_has_sse41()
-{
-#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
-    int regs[4] = { 0, 0, 0, 0 };
-    __cpuid(regs, 1);
-    return (regs[2] & (1 << 19)) != 0;
-#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
-    return __builtin_cpu_supports("sse4.1");
-#else
-    return false;
-#endif
-}
-
-// AVX-512 Foundation (F) + Vector Length (VL). VL is required because the
-// vectorized message schedules operate on 128-bit (xmm) EVEX operands. We also
-// verify the OS has enabled the full AVX-512 register state via XCR0, otherwise
-// the instructions would #UD even though the CPUID feature bits are set.
-// Shared by the SHA-256 (opt-in) and SHA-512 (default) AVX-512 backends.
-inline bool x86_runtime_has_avx512()
-{
-#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
-    int regs[4] = { 0, 0, 0, 0 };
-    __cpuid(regs, 0);
-    if (regs[0] < 7)
-        return false;
-    __cpuidex(regs, 1, 0);
-    const bool osxsave = (regs[2] & (1 << 27)) != 0;
-    if (!osxsave)
-        return false;
-    // XCR0 bits: 1 SSE, 2 AVX, 5 opmask, 6 ZMM_Hi256, 7 Hi16_ZMM -> mask 0xE6.
-    const unsigned long long xcr0 = _xgetbv(0);
-    if ((xcr0 & 0xE6ull) != 0xE6ull)
-        return false;
-    __cpuidex(regs, 7, 0);
-    const bool avx512f  = (regs[1] & (1 << 16)) != 0; // EBX bit 16
-    const bool avx512vl = (regs[1] & (1u << 31)) != 0; // EBX bit 31
-    return avx512f && avx512vl;
-#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
-    // __builtin_cpu_supports folds in the required XGETBV/OS-enablement check.
-    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl");
-#else
-    return false;
-#endif
-}
-#endif // AUTODETECT_MODE
-
 // --------------------------------------------------------------------------
 // SHA-NI backend
 // --------------------------------------------------------------------------
@@ -46,6 +46,7 @@ struct keccak_ctx : keccak_ctx_defs<Rounds>
     static constexpr size_t digest_word_bit_count = 64;
     
     inline std::span<digest_word_type, state_size> digest_span() { return hash_; }
+    inline size_t block_length() const noexcept { return block_size_; }
 
     keccak_ctx(size_t bitsize, size_t d, uint_least8_t pad);
 
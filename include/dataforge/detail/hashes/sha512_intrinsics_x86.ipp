@@ -12,16 +12,20 @@
 #include <cstdint>
 
 // Per-function ISA selection (see sha2_intrinsics_x86.ipp). There are no SHA-NI
-// instructions for the 64-bit SHA-2 variants. Two hardware paths exist:
+// instructions for the 64-bit SHA-2 variants. Three hardware paths exist:
 //
 //  AVX-512VL: uses vprorq for single-instruction 64-bit lane rotation.
-//  SSE4.1:    same XMM message-schedule structure but decomposes each vprorq
-//             into a shift-or pair; selected on CPUs without AVX-512 (e.g.
-//             Raptor Lake desktop with both P- and E-cores active).
+//  AVX2:      YMM message schedule that expands two consecutive blocks at once
+//             (the low 128-bit lane holds block N, the high lane block N+1),
+//             decomposing each rotation into a shift-or pair. BMI2 lets the
+//             scalar rounds use rorx. Selected on CPUs without AVX-512 (e.g.
+//             Raptor Lake desktop with both P- and E-cores active, Zen 1-3).
+//  SSSE3:     single-block XMM schedule with shift-or rotations; only needs
+//             pshufb/palignr, so it runs on every x86-64 CPU since Core 2.
 //
-// Both paths share the 8-way unrolled scalar compression rounds via the
-// DATAFORGE_SHA512_ROUND macro, which eliminates the 7 register-move
-// instructions that the naïve loop emits per round.
+// All paths share the 8-way unrolled scalar compression rounds in
+// sha512_compress_wk(), which eliminates the 7 register-move instructions that
+// the naïve loop emits per round.
 
 namespace dataforge::sha2_detail {
 
@@ -62,10 +66,10 @@ __m128i avx512_sha512_sigma1(__m128i x)
 #endif
 
 // ---------------------------------------------------------------------------
-// SSE4.1 sigma helpers (rotate = shift-right | shift-left, 3 insns each)
+// SSSE3 sigma helpers (rotate = shift-right | shift-left, 3 insns each)
 // ---------------------------------------------------------------------------
-DATAFORGE_SSE41_TARGET DATAFORGE_FORCEINLINE
-__m128i sse41_sha512_sigma0(__m128i x)
+DATAFORGE_SSSE3_TARGET DATAFORGE_FORCEINLINE
+__m128i ssse3_sha512_sigma0(__m128i x)
 {
     // sigma0(x) = ror(x,1) ^ ror(x,8) ^ (x >> 7)
     return _mm_xor_si128(
@@ -76,8 +80,8 @@ __m128i sse41_sha512_sigma0(__m128i x)
         _mm_srli_epi64(x, 7));
 }
 
-DATAFORGE_SSE41_TARGET DATAFORGE_FORCEINLINE
-__m128i sse41_sha512_sigma1(__m128i x)
+DATAFORGE_SSSE3_TARGET DATAFORGE_FORCEINLINE
+__m128i ssse3_sha512_sigma1(__m128i x)
 {
     // sigma1(x) = ror(x,19) ^ ror(x,61) ^ (x >> 6)
     return _mm_xor_si128(
@@ -88,6 +92,32 @@ __m128i sse41_sha512_sigma1(__m128i x)
         _mm_srli_epi64(x, 6));
 }
 
+// ---------------------------------------------------------------------------
+// AVX2 sigma helpers: the SSSE3 shift-or decomposition on four 64-bit lanes
+// (two words from each of two blocks).
+// ---------------------------------------------------------------------------
+DATAFORGE_AVX2_TARGET DATAFORGE_FORCEINLINE
+__m256i avx2_sha512_sigma0(__m256i x)
+{
+    return _mm256_xor_si256(
+        _mm256_xor_si256(
+            _mm256_or_si256(_mm256_srli_epi64(x,  1), _mm256_slli_epi64(x, 63)),
+            _mm256_or_si256(_mm256_srli_epi64(x,  8), _mm256_slli_epi64(x, 56))
+        ),
+        _mm256_srli_epi64(x, 7));
+}
+
+DATAFORGE_AVX2_TARGET DATAFORGE_FORCEINLINE
+__m256i avx2_sha512_sigma1(__m256i x)
+{
+    return _mm256_xor_si256(
+        _mm256_xor_si256(
+            _mm256_or_si256(_mm256_srli_epi64(x, 19), _mm256_slli_epi64(x, 45)),
+            _mm256_or_si256(_mm256_srli_epi64(x, 61), _mm256_slli_epi64(x,  3))
+        ),
+        _mm256_srli_epi64(x, 6));
+}
+
 // ---------------------------------------------------------------------------
 // 8-way unrolled compression-round macro.
 //
@@ -107,6 +137,33 @@ do {                                                                       \
     (h) = _T1 + _S0 + ((a & b) ^ (a & c) ^ (b & c));                     \
 } while(0)
 
+// ---------------------------------------------------------------------------
+// 80 compression rounds over a pre-computed W[t]+K[t] table. No target
+// attribute: it is force-inlined into each backend and picks up that
+// backend's ISA (e.g. rorx for the rotations under the AVX2+BMI2 target).
+// ---------------------------------------------------------------------------
+DATAFORGE_FORCEINLINE void sha512_compress_wk(uint64_t(&state)[8], const uint64_t* wk)
+{
+    uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    // 8-way unroll: argument permutation rotates the logical state vector,
+    // eliminating all inter-round register moves.
+    for (int t = 0; t < 80; t += 8) {
+        DATAFORGE_SHA512_ROUND(a,b,c,d,e,f,g,h, wk, t+0);
+        DATAFORGE_SHA512_ROUND(h,a,b,c,d,e,f,g, wk, t+1);
+        DATAFORGE_SHA512_ROUND(g,h,a,b,c,d,e,f, wk, t+2);
+        DATAFORGE_SHA512_ROUND(f,g,h,a,b,c,d,e, wk, t+3);
+        DATAFORGE_SHA512_ROUND(e,f,g,h,a,b,c,d, wk, t+4);
+        DATAFORGE_SHA512_ROUND(d,e,f,g,h,a,b,c, wk, t+5);
+        DATAFORGE_SHA512_ROUND(c,d,e,f,g,h,a,b, wk, t+6);
+        DATAFORGE_SHA512_ROUND(b,c,d,e,f,g,h,a, wk, t+7);
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
 // ---------------------------------------------------------------------------
 // AVX-512VL backend: SIMD message schedule + 8-unrolled scalar compression
 // ---------------------------------------------------------------------------
@@ -149,24 +206,7 @@ inline void process_blocks_sha512_x86_avx512(uint64_t(&state)[8], const void* ms
             _mm_store_si128(reinterpret_cast<__m128i*>(wk + 2 * j),
                             _mm_add_epi64(w[j], _mm_load_si128(Kvec + j)));
 
-        uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
-        uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
-
-        // 8-way unroll: argument permutation rotates the logical state vector,
-        // eliminating all inter-round register moves.
-        for (int t = 0; t < 80; t += 8) {
-            DATAFORGE_SHA512_ROUND(a,b,c,d,e,f,g,h, wk, t+0);
-            DATAFORGE_SHA512_ROUND(h,a,b,c,d,e,f,g, wk, t+1);
-            DATAFORGE_SHA512_ROUND(g,h,a,b,c,d,e,f, wk, t+2);
-            DATAFORGE_SHA512_ROUND(f,g,h,a,b,c,d,e, wk, t+3);
-            DATAFORGE_SHA512_ROUND(e,f,g,h,a,b,c,d, wk, t+4);
-            DATAFORGE_SHA512_ROUND(d,e,f,g,h,a,b,c, wk, t+5);
-            DATAFORGE_SHA512_ROUND(c,d,e,f,g,h,a,b, wk, t+6);
-            DATAFORGE_SHA512_ROUND(b,c,d,e,f,g,h,a, wk, t+7);
-        }
-
-        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
-        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        sha512_compress_wk(state, wk);
 
         if (--block_count == 0) break;
         data += 128;
@@ -178,12 +218,13 @@ inline void process_blocks_sha512_x86_avx512(uint64_t(&state)[8], const void* ms
 #endif
 
 // ---------------------------------------------------------------------------
-// SSE4.1 backend: identical structure, but sigma0/sigma1 use shift-or pairs
-// instead of vprorq, so it runs on any x86-64 CPU (Raptor Lake desktop,
-// Alder Lake, Skylake, etc.) without requiring AVX-512.
+// SSSE3 backend: identical structure, but sigma0/sigma1 use shift-or pairs
+// instead of vprorq. pshufb and palignr are the newest instructions it needs,
+// so it runs on any x86-64 CPU without AVX2 (Goldmont, Silvermont, older
+// Xeons) and on AVX2 CPUs for the odd trailing block.
 // ---------------------------------------------------------------------------
-DATAFORGE_SSE41_TARGET
-inline void process_blocks_sha512_x86_sse41(uint64_t(&state)[8], const void* msg, size_t block_count)
+DATAFORGE_SSSE3_TARGET
+inline void process_blocks_sha512_x86_ssse3(uint64_t(&state)[8], const void* msg, size_t block_count)
 {
     static const __m128i SHUF_MASK = _mm_set_epi64x(0x08090A0B0C0D0E0FULL, 0x0001020304050607ULL);
 
@@ -198,9 +239,9 @@ inline void process_blocks_sha512_x86_sse41(uint64_t(&state)[8], const void* msg
         for (int j = 8; j < 40; ++j) {
             const __m128i s0in = _mm_alignr_epi8(w[j - 7], w[j - 8], 8);
             const __m128i wm7  = _mm_alignr_epi8(w[j - 3], w[j - 4], 8);
-            __m128i v = _mm_add_epi64(w[j - 8], sse41_sha512_sigma0(s0in));
+            __m128i v = _mm_add_epi64(w[j - 8], ssse3_sha512_sigma0(s0in));
             v = _mm_add_epi64(v, wm7);
-            v = _mm_add_epi64(v, sse41_sha512_sigma1(w[j - 1]));
+            v = _mm_add_epi64(v, ssse3_sha512_sigma1(w[j - 1]));
             w[j] = v;
         }
 
@@ -209,28 +250,65 @@ inline void process_blocks_sha512_x86_sse41(uint64_t(&state)[8], const void* msg
             _mm_store_si128(reinterpret_cast<__m128i*>(wk + 2 * j),
                             _mm_add_epi64(w[j], _mm_load_si128(Kvec + j)));
 
-        uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
-        uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
-
-        for (int t = 0; t < 80; t += 8) {
-            DATAFORGE_SHA512_ROUND(a,b,c,d,e,f,g,h, wk, t+0);
-            DATAFORGE_SHA512_ROUND(h,a,b,c,d,e,f,g, wk, t+1);
-            DATAFORGE_SHA512_ROUND(g,h,a,b,c,d,e,f, wk, t+2);
-            DATAFORGE_SHA512_ROUND(f,g,h,a,b,c,d,e, wk, t+3);
-            DATAFORGE_SHA512_ROUND(e,f,g,h,a,b,c,d, wk, t+4);
-            DATAFORGE_SHA512_ROUND(d,e,f,g,h,a,b,c, wk, t+5);
-            DATAFORGE_SHA512_ROUND(c,d,e,f,g,h,a,b, wk, t+6);
-            DATAFORGE_SHA512_ROUND(b,c,d,e,f,g,h,a, wk, t+7);
-        }
-
-        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
-        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        sha512_compress_wk(state, wk);
 
         if (--block_count == 0) break;
         data += 128;
     }
 }
 
+// ---------------------------------------------------------------------------
+// AVX2 backend: the message schedule of two consecutive blocks is expanded in
+// one pass. vpshufb / vpalignr operate within 128-bit lanes, so each YMM vector
+// is simply the SSSE3 schedule vector of block N (low lane) next to the one of
+// block N+1 (high lane), and the recurrence needs no cross-lane shuffles. The
+// compression rounds stay sequential (block N+1 depends on block N's state);
+// only the schedule is shared. An odd trailing block goes to the SSSE3 path.
+// ---------------------------------------------------------------------------
+DATAFORGE_AVX2_TARGET
+inline void process_blocks_sha512_x86_avx2(uint64_t(&state)[8], const void* msg, size_t block_count)
+{
+    static const __m256i SHUF_MASK = _mm256_set_epi64x(
+        0x08090A0B0C0D0E0FULL, 0x0001020304050607ULL,
+        0x08090A0B0C0D0E0FULL, 0x0001020304050607ULL);
+
+    const auto* data = reinterpret_cast<const uint8_t*>(msg);
+    const auto* Kvec = reinterpret_cast<const __m128i*>(sha2_def_base<512>::K);
+
+    __m256i w[40];
+    alignas(64) uint64_t wk[2][80];
+    for (; block_count >= 2; block_count -= 2, data += 256) {
+        for (int i = 0; i < 8; ++i) {
+            const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+            const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 128 + 16 * i));
+            w[i] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), SHUF_MASK);
+        }
+
+        for (int j = 8; j < 40; ++j) {
+            const __m256i s0in = _mm256_alignr_epi8(w[j - 7], w[j - 8], 8);
+            const __m256i wm7  = _mm256_alignr_epi8(w[j - 3], w[j - 4], 8);
+            __m256i v = _mm256_add_epi64(w[j - 8], avx2_sha512_sigma0(s0in));
+            v = _mm256_add_epi64(v, wm7);
+            v = _mm256_add_epi64(v, avx2_sha512_sigma1(w[j - 1]));
+            w[j] = v;
+        }
+
+        // Both blocks use the same K[t] pair, so broadcast it to both lanes
+        // and split the sums into one W+K table per block.
+        for (int j = 0; j < 40; ++j) {
+            const __m256i v = _mm256_add_epi64(w[j], _mm256_broadcastsi128_si256(_mm_load_si128(Kvec + j)));
+            _mm_store_si128(reinterpret_cast<__m128i*>(wk[0] + 2 * j), _mm256_castsi256_si128(v));
+            _mm_store_si128(reinterpret_cast<__m128i*>(wk[1] + 2 * j), _mm256_extracti128_si256(v, 1));
+        }
+
+        sha512_compress_wk(state, wk[0]);
+        sha512_compress_wk(state, wk[1]);
+    }
+
+    if (block_count)
+        process_blocks_sha512_x86_ssse3(state, data, 1);
+}
+
 #undef DATAFORGE_SHA512_ROUND
 
 }
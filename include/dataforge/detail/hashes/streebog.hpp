@@ -11,8 +11,16 @@
 #include <array>
 #include <algorithm>
 
+#include "dataforge/detail/config.hpp"
+
 #include "../utility/digest_base.hpp"
 
+#if DATAFORGE_TARGET_X86
+#define DATAFORGE_ACCEL_CAN_COMPILE_X86_STREEBOG 1
+#else
+#define DATAFORGE_ACCEL_CAN_COMPILE_X86_STREEBOG 0
+#endif
+
 namespace dataforge::streebog_detail {
 
 struct streebog_impl : digest_base<streebog_impl, 64>
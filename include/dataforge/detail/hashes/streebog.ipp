@@ -7,6 +7,8 @@
 ==============================================================================*/
 
 #include <algorithm>
+#include "../cpu_features.hpp"
+#include "../autotune.hpp"
 
 namespace dataforge::streebog_detail {
 
@@ -622,7 +624,7 @@ inline void e(uint_least64_t* K, const uint_least64_t* m)
 	}
 }
 
-inline void gN(uint_least64_t* h, const uint_least64_t* m, uint_least64_t N)
+inline void gN_scalar(uint_least64_t* h, const uint_least64_t* m, uint_least64_t N)
 {
     uint_least64_t hN[8];
 	std::copy(h, h + 8, hN);
@@ -633,21 +635,76 @@ inline void gN(uint_least64_t* h, const uint_least64_t* m, uint_least64_t N)
 	xor_blocks(h, m);
 }
 
-inline void addm(const uint_least64_t* m64, uint64_t* h)
+// Sigma += m modulo 2^512: a single carry bit rippled through eight 64-bit limbs.
+inline void addm(const uint_least64_t* m64, uint_least64_t* h)
 {
-	bool carry = false, overflow = false;
-	for (int i = 0; i < 8; i++)
-	{
-		uint_least64_t t = h[i] + m64[i];
-		overflow = t < h[i] || t < m64[i];
-		if (carry) {
-			h[i] = t + 1;
-			carry = overflow || !h[i];
-		} else {
-			h[i] = t;
-			carry = overflow;
-		}
-	}
+    uint_least64_t carry = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        uint_least64_t const t = h[i] + carry;
+        carry = t < carry;
+        h[i] = t + m64[i];
+        carry += h[i] < t;
+    }
+}
+
+} // namespace dataforge::streebog_detail
+
+#if DATAFORGE_ACCEL_CAN_COMPILE_X86_STREEBOG
+#   include "streebog_intrinsics_x86.ipp"
+#endif
+
+namespace dataforge::streebog_detail {
+
+using gN_fn_t = void(*)(uint_least64_t*, const uint_least64_t*, uint_least64_t);
+
+inline accel_backend<gN_fn_t> select_gN_backend() noexcept
+{
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
+#   if DATAFORGE_ACCEL_CAN_COMPILE_X86_STREEBOG
+    if (cpu_has(cpu_feature::x86_sse2))
+        return { &gN_x86_sse2, "sse2" };
+#   endif
+#elif DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_X86 && DATAFORGE_ACCEL_CAN_COMPILE_X86_STREEBOG
+    return { &gN_x86_sse2, "sse2" };
+#endif
+    return { &gN_scalar, "scalar" };
+}
+
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
+inline std::vector<accel_backend<gN_fn_t>> gN_backend_candidates()
+{
+    std::vector<accel_backend<gN_fn_t>> result;
+    if (auto preferred = select_gN_backend(); preferred.fn != &gN_scalar) result.push_back(preferred);
+    result.push_back({ &gN_scalar, "scalar" });
+    return result;
+}
+
+// gN compresses one block per call, so there are no size classes to tell apart
+inline tuned_backend<gN_fn_t> const& gN_backend()
+{
+    static const tuned_backend<gN_fn_t> backend{ "streebog", select_gN_backend(), gN_backend_candidates(), 64,
+        [](gN_fn_t fn, const void* data, size_t block_count) {
+            uint_least64_t h[8] = {};
+            auto const* m = static_cast<const uint_least64_t*>(data);
+            for (size_t i = 0; i < block_count; ++i) fn(h, m + 8 * i, 512 * i);
+        }, false };
+    return backend;
+}
+
+inline const bool streebog_backend_registered = register_backend("streebog", [] { return gN_backend().name(); });
+#else
+inline const bool streebog_backend_registered = register_backend("streebog", [] { return select_gN_backend().name; });
+#endif
+
+inline void gN(uint_least64_t* h, const uint_least64_t* m, uint_least64_t N)
+{
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
+    static const auto& backend = gN_backend();
+    backend(1).fn(h, m, N);
+#else
+    select_gN_backend().fn(h, m, N);
+#endif
 }
 
 inline streebog_impl::streebog_impl(size_t hash_size_val)
@@ -669,6 +726,7 @@ inline void streebog_impl::reset() noexcept
     total = 0;
     std::fill(h.begin(), h.end(), hs == 512 ? 0ull : 0x0101010101010101ull);
     std::fill(S.begin(), S.end(), 0);
+    bit_count = 0;
 }
 
 inline void streebog_impl::process_block(const void* msg)
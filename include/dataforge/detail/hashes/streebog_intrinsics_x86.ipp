@@ -0,0 +1,119 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#if DATAFORGE_ACCEL_CAN_COMPILE_X86_STREEBOG
+
+#include <emmintrin.h>
+
+#include <cstdint>
+
+namespace dataforge::streebog_detail {
+
+// --------------------------------------------------------------------------
+// Streebog SSE2 backend.
+//
+// The 512-bit state lives in four XMM registers, x0 = {w0, w1} ... x3 = {w6, w7}.
+// The LPS transform produces output word I from byte I of every input word, so
+// 16-bit lane Row of x_k carries bytes 2*Row and 2*Row+1 of word 2k, and lane
+// Row+4 the same bytes of word 2k+1. One pextrw therefore feeds two table
+// lookups, and each row yields output words 2*Row and 2*Row+1 — exactly one
+// XMM register of the result. Sixteen extractions replace the 64-byte spill
+// and byte reload of the scalar path.
+// --------------------------------------------------------------------------
+
+template <int Row>
+DATAFORGE_SSE2_TARGET DATAFORGE_FORCEINLINE
+__m128i sse2_streebog_lps_row(__m128i x0, __m128i x1, __m128i x2, __m128i x3)
+{
+    unsigned int w = static_cast<uint16_t>(_mm_extract_epi16(x0, Row));
+    uint_least64_t r0 = T[0][w & 0xff];
+    uint_least64_t r1 = T[0][w >> 8];
+    w = static_cast<uint16_t>(_mm_extract_epi16(x0, Row + 4));
+    r0 ^= T[1][w & 0xff];
+    r1 ^= T[1][w >> 8];
+    w = static_cast<uint16_t>(_mm_extract_epi16(x1, Row));
+    r0 ^= T[2][w & 0xff];
+    r1 ^= T[2][w >> 8];
+    w = static_cast<uint16_t>(_mm_extract_epi16(x1, Row + 4));
+    r0 ^= T[3][w & 0xff];
+    r1 ^= T[3][w >> 8];
+    w = static_cast<uint16_t>(_mm_extract_epi16(x2, Row));
+    r0 ^= T[4][w & 0xff];
+    r1 ^= T[4][w >> 8];
+    w = static_cast<uint16_t>(_mm_extract_epi16(x2, Row + 4));
+    r0 ^= T[5][w & 0xff];
+    r1 ^= T[5][w >> 8];
+    w = static_cast<uint16_t>(_mm_extract_epi16(x3, Row));
+    r0 ^= T[6][w & 0xff];
+    r1 ^= T[6][w >> 8];
+    w = static_cast<uint16_t>(_mm_extract_epi16(x3, Row + 4));
+    r0 ^= T[7][w & 0xff];
+    r1 ^= T[7][w >> 8];
+    return _mm_set_epi64x(static_cast<long long>(r1), static_cast<long long>(r0));
+}
+
+DATAFORGE_SSE2_TARGET DATAFORGE_FORCEINLINE
+void sse2_streebog_lps(__m128i& x0, __m128i& x1, __m128i& x2, __m128i& x3)
+{
+    __m128i const y0 = sse2_streebog_lps_row<0>(x0, x1, x2, x3);
+    __m128i const y1 = sse2_streebog_lps_row<1>(x0, x1, x2, x3);
+    __m128i const y2 = sse2_streebog_lps_row<2>(x0, x1, x2, x3);
+    __m128i const y3 = sse2_streebog_lps_row<3>(x0, x1, x2, x3);
+    x0 = y0; x1 = y1; x2 = y2; x3 = y3;
+}
+
+// g_N(h, m) with h, m and the round key kept in registers for all 13 rounds.
+DATAFORGE_SSE2_TARGET
+inline void gN_x86_sse2(uint_least64_t* h, const uint_least64_t* m, uint_least64_t N)
+{
+    __m128i const h0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h));
+    __m128i const h1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + 2));
+    __m128i const h2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + 4));
+    __m128i const h3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + 6));
+
+    __m128i const m0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m));
+    __m128i const m1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m + 2));
+    __m128i const m2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m + 4));
+    __m128i const m3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m + 6));
+
+    // K1 = LPS(h ^ N)
+    __m128i k0 = _mm_xor_si128(h0, _mm_set_epi64x(0, static_cast<long long>(N)));
+    __m128i k1 = h1, k2 = h2, k3 = h3;
+    sse2_streebog_lps(k0, k1, k2, k3);
+
+    // E(K, m)
+    __m128i s0 = _mm_xor_si128(k0, m0);
+    __m128i s1 = _mm_xor_si128(k1, m1);
+    __m128i s2 = _mm_xor_si128(k2, m2);
+    __m128i s3 = _mm_xor_si128(k3, m3);
+    for (int i = 0; i < 12; ++i)
+    {
+        sse2_streebog_lps(s0, s1, s2, s3);
+
+        k0 = _mm_xor_si128(k0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&RC[i][0])));
+        k1 = _mm_xor_si128(k1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&RC[i][2])));
+        k2 = _mm_xor_si128(k2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&RC[i][4])));
+        k3 = _mm_xor_si128(k3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&RC[i][6])));
+        sse2_streebog_lps(k0, k1, k2, k3);
+
+        s0 = _mm_xor_si128(s0, k0);
+        s1 = _mm_xor_si128(s1, k1);
+        s2 = _mm_xor_si128(s2, k2);
+        s3 = _mm_xor_si128(s3, k3);
+    }
+
+    // h ^= E(K, m) ^ m
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(h), _mm_xor_si128(h0, _mm_xor_si128(s0, m0)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(h + 2), _mm_xor_si128(h1, _mm_xor_si128(s1, m1)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(h + 4), _mm_xor_si128(h2, _mm_xor_si128(s2, m2)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(h + 6), _mm_xor_si128(h3, _mm_xor_si128(s3, m3)));
+}
+
+} // namespace dataforge::streebog_detail
+
+#endif // DATAFORGE_ACCEL_CAN_COMPILE_X86_STREEBOG
@@ -24,6 +24,7 @@ struct tiger_base
 	static const uint64_t TIGER_S4[256];
 
 	static const int input_length_size = 8;
+	static constexpr bool merkle_damgard = true;
 };
 
 struct tiger_impl : tiger_base, digest_base<tiger_impl, 64>
@@ -18,6 +18,7 @@ struct whirlpool_impl : digest_base<whirlpool_impl, 64, uint_least64_t, 4>
     static constexpr size_t digest_length() { return 64; }
     static constexpr std::endian digest_endianness() { return std::endian::big; }
     static constexpr size_t input_length_size = 32;
+    static constexpr bool merkle_damgard = true;
 
     using word_type = uint_least64_t;
     using digest_word_type = word_type;
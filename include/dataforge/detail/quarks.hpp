@@ -179,6 +179,25 @@ concept IntegralBasedQuark = is_int_qrk_v<typename T::int_qrk_t, BitSzV>;
 template <typename T>
 concept SomeIntegralBasedQuark = sizeof(typename T::int_qrk_t) > 0;
 
+// Converters that can run on independent pieces of the input report it by
+// chunk_alignment(): splitting the input after multiples of input_block
+// elements, converting every piece by a fresh converter (finished at the end)
+// and joining the outputs gives the output of one converter over the whole
+// input, with output_block elements for every input_block elements. An empty
+// value means the converter (in its current mode) can't be split.
+struct chunk_independence
+{
+    size_t input_block = 0;
+    size_t output_block = 0;
+
+    explicit operator bool() const noexcept { return input_block != 0; }
+};
+
+// Converters that know how much output an input makes report it by
+// exact_output_size(n) or, when only a bound is known, max_output_size(n):
+// the number of output elements for n input elements pushed to a fresh
+// converter and finished.
+
 template <typename ErrorHandlerT>
 class generic_pusher : protected ErrorHandlerT
 {
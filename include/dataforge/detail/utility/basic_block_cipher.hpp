@@ -162,6 +162,28 @@ public:
     }
 
     inline cipher_mode_type cipher_mode() const { return (cipher_mode_type)cipher_mode_; }
+    inline padding_type padding() const { return pt; }
+
+    // ECB without padding transforms every block on its own
+    chunk_independence chunk_alignment() const noexcept
+    {
+        if (cipher_mode() == cipher_mode_type::ECB && pt == padding_type::none) {
+            return { block_bsize(), block_bsize() };
+        }
+        return {};
+    }
+
+    // the ciphertext of n bytes: a whole number of blocks with padding,
+    // n bytes without it (the stream modes and ciphertext stealing)
+    size_t encrypted_size(size_t n) const noexcept
+    {
+        size_t const bsz = block_bsize();
+        switch (pt) {
+        case padding_type::pkcs: return (n / bsz + 1) * bsz;
+        case padding_type::zero: return (n + bsz - 1) / bsz * bsz;
+        default: return n;
+        }
+    }
 
     inline word_type* iv_begin() noexcept { return reinterpret_cast<word_type*>(obytes_begin()) - algo_t::block_wsize(); }
     inline word_type* iv_backup_begin() noexcept { return reinterpret_cast<word_type*>(obytes_begin()) - 2 * algo_t::block_wsize(); }
@@ -286,6 +308,9 @@ public:
     }
 
     inline void reset() { ImplT::alg().reset(); }
+
+    chunk_independence chunk_alignment() const noexcept { return ImplT::alg().chunk_alignment(); }
+    size_t exact_output_size(size_t n) const noexcept { return ImplT::alg().encrypted_size(n); }
 };
 
 template <typename ImplT, typename ErrorHandlerT>
@@ -344,6 +369,9 @@ public:
     }
 
     inline void reset() { ImplT::alg().reset(); }
+
+    chunk_independence chunk_alignment() const noexcept { return ImplT::alg().chunk_alignment(); }
+    static constexpr size_t max_output_size(size_t n) noexcept { return n; }
 };
 
 }
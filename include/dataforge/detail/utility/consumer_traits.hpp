@@ -0,0 +1,30 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <type_traits>
+
+namespace dataforge {
+
+// A consumer with its own buffering (fd_sink, uring_file_sink) opts in to
+// being flushed and finished together with the chain that writes to it:
+//     using consumer_category = flushing_consumer_tag;
+// or by a specialization of is_flushing_consumer. Other consumers are left
+// alone, even if they have flush() or finish() members of their own (a
+// nested quark_push_iterator is finished by its owner, not by the chain).
+struct flushing_consumer_tag {};
+
+template <typename T> struct is_flushing_consumer : std::false_type {};
+
+template <typename T>
+requires(std::is_same_v<typename T::consumer_category, flushing_consumer_tag>)
+struct is_flushing_consumer<T> : std::true_type {};
+
+template <typename T> constexpr bool is_flushing_consumer_v = is_flushing_consumer<T>::value;
+
+}
@@ -0,0 +1,116 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "instrumentation.hpp"
+
+namespace dataforge {
+
+// Execution policies of push_converter.
+//
+// depth_first_execution (the default) hands everything a stage emits to the
+// next stage at once, so every element or small span runs through the rest
+// of the chain before the stage continues.
+struct depth_first_execution {};
+
+// stage_major_execution collects the output of every stage in a chunk of
+// ChunkBytesV bytes and passes the chunk on when it is full, on flush() and
+// on finish(). Each stage then runs over a whole chunk with its code and
+// tables hot, and the bulk kernels downstream see large spans. The output
+// reaches the sink later than in depth-first mode: when the chunks fill up
+// or the pipeline is flushed.
+template <size_t ChunkBytesV = 64 * 1024>
+struct stage_major_execution
+{
+    static_assert(ChunkBytesV > 0);
+    static constexpr size_t chunk_bytes = ChunkBytesV;
+};
+
+template <typename T> struct is_stage_major_execution : std::false_type {};
+template <size_t ChunkBytesV> struct is_stage_major_execution<stage_major_execution<ChunkBytesV>> : std::true_type {};
+
+template <typename T>
+concept ExecutionPolicy = std::is_same_v<T, depth_first_execution> || is_stage_major_execution<T>::value;
+
+template <typename T>
+concept PipelinePolicy = InstrumentationPolicy<T> || ExecutionPolicy<T>;
+
+// the policies given to a converter in any order, defaults for the rest
+template <typename ... PolicyTs>
+struct pipeline_policies
+{
+    using instrumentation = no_instrumentation;
+    using execution = depth_first_execution;
+};
+
+template <InstrumentationPolicy PolicyT, typename ... PolicyTs>
+struct pipeline_policies<PolicyT, PolicyTs ...> : pipeline_policies<PolicyTs ...>
+{
+    using instrumentation = PolicyT;
+};
+
+template <ExecutionPolicy PolicyT, typename ... PolicyTs>
+struct pipeline_policies<PolicyT, PolicyTs ...> : pipeline_policies<PolicyTs ...>
+{
+    using execution = PolicyT;
+};
+
+// The output chunk of one stage. Stages whose output is not a sequence of
+// integral elements (e.g. tagged fragments) have none and pass through.
+template <typename ET, size_t ChunkBytesV>
+class stage_chunk
+{
+public:
+    static constexpr size_t capacity = (std::max)(ChunkBytesV / sizeof(ET), size_t{ 1 });
+
+    template <typename SpanT>
+    void append(SpanT sp)
+    {
+        if (data_.capacity() < capacity) data_.reserve(capacity);
+        data_.insert(data_.end(), sp.begin(), sp.end());
+    }
+
+    void append(ET e)
+    {
+        if (data_.capacity() < capacity) data_.reserve(capacity);
+        data_.push_back(e);
+    }
+
+    bool empty() const noexcept { return data_.empty(); }
+    bool full() const noexcept { return data_.size() >= capacity; }
+    std::span<const ET> span() const noexcept { return data_; }
+    void clear() noexcept { data_.clear(); }
+
+private:
+    std::vector<ET> data_;
+};
+
+template <typename ConverterT, size_t ChunkBytesV, typename = void>
+struct stage_chunk_for { struct type {}; };
+
+template <typename ConverterT, size_t ChunkBytesV>
+struct stage_chunk_for<ConverterT, ChunkBytesV, std::enable_if_t<std::is_integral_v<typename ConverterT::output_element_type>>>
+{
+    using type = stage_chunk<typename ConverterT::output_element_type, ChunkBytesV>;
+};
+
+template <typename ExecutionT, typename CvtTupleT> struct stage_chunks {};
+
+template <size_t ChunkBytesV, typename ... ConverterTs>
+struct stage_chunks<stage_major_execution<ChunkBytesV>, std::tuple<ConverterTs ...>>
+{
+    std::tuple<typename stage_chunk_for<ConverterTs, ChunkBytesV>::type ...> chunks;
+};
+
+}
@@ -0,0 +1,236 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "../config.hpp"
+
+#if DATAFORGE_TARGET_X86 && defined(_MSC_VER)
+#  include <intrin.h>
+#elif DATAFORGE_TARGET_X86 && (defined(__GNUC__) || defined(__clang__))
+#  include <x86intrin.h>
+#endif
+
+// Defining DATAFORGE_USDT makes the instrumented converters fire the USDT
+// probe dataforge:stage(stage index, cycles) on every stage exit.
+#if defined(DATAFORGE_USDT) && defined(__has_include)
+#   if __has_include(<sys/sdt.h>)
+#       include <sys/sdt.h>
+#       define DATAFORGE_STAGE_PROBE(stage, cycles) DTRACE_PROBE2(dataforge, stage, stage, cycles)
+#   endif
+#endif
+#ifndef DATAFORGE_STAGE_PROBE
+#   define DATAFORGE_STAGE_PROBE(stage, cycles) ((void)0)
+#endif
+
+// the disabled policy must not grow the converters
+#if defined(_MSC_VER)
+#   define DATAFORGE_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#   define DATAFORGE_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+namespace dataforge {
+
+// Instrumentation policies of push_converter / pull_converter.
+// no_instrumentation (the default) compiles to the plain pipeline.
+struct no_instrumentation { static constexpr bool enabled = false; };
+
+// stage_instrumentation counts the traffic and the time of every stage.
+struct stage_instrumentation { static constexpr bool enabled = true; };
+
+template <typename T>
+concept InstrumentationPolicy = std::is_same_v<T, no_instrumentation> || std::is_same_v<T, stage_instrumentation>;
+
+struct stage_stats
+{
+    uint64_t calls = 0;             // push / flush / finish or pull invocations
+    uint64_t input_elements = 0;    // elements received
+    uint64_t output_elements = 0;   // elements passed on
+    uint64_t consumer_calls = 0;    // push: deliveries to the next stage or the sink
+    uint64_t provider_calls = 0;    // pull: requests to the previous stage or the source
+    uint64_t cycles = 0;            // time in the stage itself, without its neighbours
+};
+
+// cycles are TSC ticks on x86 and nanoseconds elsewhere
+template <size_t N>
+struct pipeline_stats
+{
+    std::array<stage_stats, N> stages{};
+    uint64_t endpoint_cycles = 0;   // time in the output sink (push) or the input source (pull)
+};
+
+inline uint64_t instrumentation_clock() noexcept
+{
+#if DATAFORGE_TARGET_X86 && (defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__))
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+namespace instrumentation_detail {
+
+template <typename DataT>
+inline uint64_t element_count(DataT const& data) noexcept
+{
+    if constexpr (requires { data.size(); }) {
+        return data.size();
+    } else {
+        return 1;
+    }
+}
+
+}
+
+template <typename PolicyT, size_t N> class instrumentation_state;
+
+template <size_t N>
+class instrumentation_state<no_instrumentation, N>
+{
+public:
+    struct scope {};
+
+    static constexpr scope stage_scope(size_t) noexcept { return {}; }
+    template <typename DataT> static constexpr void count_input(size_t, DataT const&) noexcept {}
+    template <typename DataT> static constexpr void count_output(size_t, DataT const&) noexcept {}
+
+    template <size_t I, typename ConsumerT>
+    static constexpr ConsumerT consumer(ConsumerT c) noexcept { return c; }
+
+    template <size_t I, typename ProviderT>
+    static constexpr ProviderT provider(ProviderT p) noexcept { return p; }
+};
+
+template <size_t N>
+class instrumentation_state<stage_instrumentation, N>
+{
+    static constexpr size_t endpoint = N;
+
+public:
+    // Times the enclosing block and charges it to a stage, less the time of
+    // the scopes nested in it (the neighbouring stages it calls).
+    class scope
+    {
+    public:
+        scope(instrumentation_state& st, size_t stage) noexcept
+            : st_{ st }, stage_{ stage }, nested_{ st.nested_cycles_ }, start_{ instrumentation_clock() }
+        {
+            st_.nested_cycles_ = 0;
+        }
+
+        scope(scope const&) = delete;
+        scope& operator=(scope const&) = delete;
+
+        ~scope()
+        {
+            uint64_t const elapsed = instrumentation_clock() - start_;
+            uint64_t const own = elapsed - st_.nested_cycles_;
+            if (stage_ == endpoint) {
+                st_.stats_.endpoint_cycles += own;
+            } else {
+                st_.stats_.stages[stage_].cycles += own;
+                ++st_.stats_.stages[stage_].calls;
+            }
+            st_.nested_cycles_ = nested_ + elapsed;
+            DATAFORGE_STAGE_PROBE(stage_, own);
+        }
+
+    private:
+        instrumentation_state& st_;
+        size_t stage_;
+        uint64_t nested_;
+        uint64_t start_;
+    };
+
+    scope stage_scope(size_t stage) noexcept { return scope{ *this, stage }; }
+
+    template <typename DataT>
+    void count_input(size_t stage, DataT const& data) noexcept
+    {
+        stats_.stages[stage].input_elements += instrumentation_detail::element_count(data);
+    }
+
+    template <typename DataT>
+    void count_output(size_t stage, DataT const& data) noexcept
+    {
+        stats_.stages[stage].output_elements += instrumentation_detail::element_count(data);
+    }
+
+    // wraps the consumer stage I pushes into
+    template <size_t I, typename ConsumerT>
+    auto consumer(ConsumerT c) noexcept
+    {
+        return counting_consumer<I, ConsumerT>{ *this, std::move(c) };
+    }
+
+    // wraps the provider stage I pulls from
+    template <size_t I, typename ProviderT>
+    auto provider(ProviderT p) noexcept
+    {
+        return counting_provider<I, ProviderT>{ *this, std::move(p) };
+    }
+
+    pipeline_stats<N> const& stats() const noexcept { return stats_; }
+    void reset() noexcept { stats_ = {}; }
+
+private:
+    template <size_t I, typename ConsumerT>
+    struct counting_consumer
+    {
+        instrumentation_state& st;
+        ConsumerT cons;
+
+        template <typename DataT>
+        void operator()(DataT&& data)
+        {
+            ++st.stats_.stages[I].consumer_calls;
+            st.count_output(I, data);
+            if constexpr (I + 1 == N) {
+                scope sink{ st, endpoint };
+                cons(std::forward<DataT>(data));
+            } else {
+                cons(std::forward<DataT>(data));
+            }
+        }
+    };
+
+    template <size_t I, typename ProviderT>
+    struct counting_provider
+    {
+        instrumentation_state& st;
+        ProviderT prov;
+
+        auto operator()()
+        {
+            ++st.stats_.stages[I].provider_calls;
+            auto fetch = [this] {
+                if constexpr (I == 0) {
+                    scope source{ st, endpoint };
+                    return prov();
+                } else {
+                    return prov();
+                }
+            };
+            auto r = fetch();
+            st.count_input(I, r);
+            return r;
+        }
+    };
+
+    pipeline_stats<N> stats_;
+    uint64_t nested_cycles_ = 0;
+};
+
+}
@@ -0,0 +1,313 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#   include <io.h>
+#else
+#   include <sys/types.h>
+#   include <sys/uio.h>
+#   include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#   include <linux/io_uring.h>
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#       define DATAFORGE_HAS_IO_URING 1
+#   endif
+#endif
+
+namespace dataforge {
+
+[[noreturn]] inline void throw_io_error(int err, const char* what)
+{
+    throw std::system_error(err, std::generic_category(), what);
+}
+
+#if defined(_WIN32)
+
+// blocking positional I/O on the handle of a CRT descriptor: the offset is
+// passed in an OVERLAPPED, which a synchronous handle takes as the position
+inline OVERLAPPED overlapped_at(uint64_t offset) noexcept
+{
+    OVERLAPPED ov{};
+    ov.Offset = static_cast<DWORD>(offset);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    return ov;
+}
+
+inline size_t pread_full(int fd, void* buf, size_t size, uint64_t offset)
+{
+    HANDLE const h = reinterpret_cast<HANDLE>(::_get_osfhandle(fd));
+    size_t done = 0;
+    while (done < size) {
+        OVERLAPPED ov = overlapped_at(offset + done);
+        DWORD n = 0;
+        if (!::ReadFile(h, static_cast<char*>(buf) + done, static_cast<DWORD>((std::min)(size - done, size_t{ 1 } << 30)), &n, &ov)) {
+            DWORD const err = ::GetLastError();
+            if (err == ERROR_HANDLE_EOF) break;
+            throw std::system_error(static_cast<int>(err), std::system_category(), "ReadFile failed");
+        }
+        if (!n) break;
+        done += n;
+    }
+    return done;
+}
+
+inline void pwrite_full(int fd, const void* buf, size_t size, uint64_t offset)
+{
+    HANDLE const h = reinterpret_cast<HANDLE>(::_get_osfhandle(fd));
+    for (size_t done = 0; done < size;) {
+        OVERLAPPED ov = overlapped_at(offset + done);
+        DWORD n = 0;
+        if (!::WriteFile(h, static_cast<const char*>(buf) + done, static_cast<DWORD>((std::min)(size - done, size_t{ 1 } << 30)), &n, &ov)) {
+            throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), "WriteFile failed");
+        }
+        done += n;
+    }
+}
+
+#else
+
+// blocking positional I/O that retries short transfers and EINTR
+inline size_t pread_full(int fd, void* buf, size_t size, uint64_t offset)
+{
+    size_t done = 0;
+    while (done < size) {
+        ssize_t const n = ::pread(fd, static_cast<char*>(buf) + done, size - done, static_cast<off_t>(offset + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw_io_error(errno, "pread failed");
+        }
+        if (!n) break;
+        done += static_cast<size_t>(n);
+    }
+    return done;
+}
+
+inline void pwrite_full(int fd, const void* buf, size_t size, uint64_t offset)
+{
+    for (size_t done = 0; done < size;) {
+        ssize_t const n = ::pwrite(fd, static_cast<const char*>(buf) + done, size - done, static_cast<off_t>(offset + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw_io_error(errno, "pwrite failed");
+        }
+        done += static_cast<size_t>(n);
+    }
+}
+
+#endif
+
+#if defined(DATAFORGE_HAS_IO_URING)
+
+// A minimal io_uring submission/completion queue over the raw system calls.
+// open() returns false where the kernel refuses io_uring (an old kernel,
+// a seccomp filter), so that the caller can fall back to pread/pwrite.
+class io_uring_queue
+{
+public:
+    struct completion
+    {
+        uint64_t user_data;
+        int result;
+    };
+
+    io_uring_queue() = default;
+    io_uring_queue(io_uring_queue const&) = delete;
+    io_uring_queue& operator=(io_uring_queue const&) = delete;
+
+    ~io_uring_queue() { close(); }
+
+    bool open(unsigned entries) noexcept
+    {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        int const fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+        if (fd < 0) return false;
+        fd_ = fd;
+
+        sq_map_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_map_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        bool const single_map = p.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_map) sq_map_size_ = cq_map_size_ = (std::max)(sq_map_size_, cq_map_size_);
+
+        sq_map_ = ::mmap(nullptr, sq_map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if (sq_map_ == MAP_FAILED) return fail();
+        cq_map_ = single_map ? sq_map_ : ::mmap(nullptr, cq_map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+        if (cq_map_ == MAP_FAILED) return fail();
+        sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return fail();
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(sq_map_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sq_entries_ = p.sq_entries;
+        sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        auto* cq = static_cast<char*>(cq_map_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    // fixed buffers skip the page pinning of every request; false when the
+    // kernel refuses them (RLIMIT_MEMLOCK), plain requests work then
+    bool register_buffers(iovec const* bufs, unsigned count) noexcept
+    {
+        fixed_ = ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, bufs, count) == 0;
+        return fixed_;
+    }
+
+    void read(int fd, void* buf, unsigned size, uint64_t offset, unsigned buf_index, uint64_t user_data)
+    {
+        prepare(fixed_ ? IORING_OP_READ_FIXED : IORING_OP_READ, fd, buf, size, offset, buf_index, user_data);
+    }
+
+    void write(int fd, const void* buf, unsigned size, uint64_t offset, unsigned buf_index, uint64_t user_data)
+    {
+        prepare(fixed_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE, fd, const_cast<void*>(buf), size, offset, buf_index, user_data);
+    }
+
+    // hands the prepared requests to the kernel
+    void submit()
+    {
+        while (unsubmitted_) enter(0, 0);
+    }
+
+    // submits the prepared requests and waits for a completion
+    completion wait()
+    {
+        for (;;) {
+            if (!reaped_.empty()) {
+                completion c = reaped_.front();
+                reaped_.pop_front();
+                return c;
+            }
+            if (completion c; pop(c)) return c;
+            enter(1, IORING_ENTER_GETEVENTS);
+        }
+    }
+
+private:
+    void prepare(uint8_t op, int fd, void* buf, unsigned size, uint64_t offset, unsigned buf_index, uint64_t user_data)
+    {
+        unsigned const tail = *sq_tail_;
+        if (tail - std::atomic_ref<unsigned>{ *sq_head_ }.load(std::memory_order_acquire) == sq_entries_) submit();
+        unsigned const index = tail & sq_mask_;
+        io_uring_sqe& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = op;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uint64_t>(buf);
+        sqe.len = size;
+        sqe.off = offset;
+        sqe.buf_index = static_cast<uint16_t>(buf_index);
+        sqe.user_data = user_data;
+        sq_array_[index] = index;
+        std::atomic_ref<unsigned>{ *sq_tail_ }.store(tail + 1, std::memory_order_release);
+        ++unsubmitted_;
+    }
+
+    bool pop(completion& c) noexcept
+    {
+        unsigned const head = *cq_head_;
+        if (head == std::atomic_ref<unsigned>{ *cq_tail_ }.load(std::memory_order_acquire)) return false;
+        io_uring_cqe const& cqe = cqes_[head & cq_mask_];
+        c = completion{ cqe.user_data, cqe.res };
+        std::atomic_ref<unsigned>{ *cq_head_ }.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // EAGAIN/EBUSY mean the kernel has no room for more requests until
+    // completions are consumed: the posted ones are moved aside for wait(),
+    // and with none posted yet the call blocks until a request completes,
+    // so that submit() never spins on the system call
+    void enter(unsigned min_complete, unsigned flags)
+    {
+        for (;;) {
+            long const n = ::syscall(__NR_io_uring_enter, fd_, unsubmitted_, min_complete, flags, nullptr, 0);
+            if (n >= 0) {
+                unsubmitted_ -= static_cast<unsigned>(n);
+                return;
+            }
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EBUSY) throw_io_error(errno, "io_uring_enter failed");
+
+            size_t const reaped = reaped_.size();
+            for (completion c; pop(c);) reaped_.push_back(c);
+            if (reaped_.size() != reaped) {
+                if (min_complete) return;
+                continue;
+            }
+            if (::syscall(__NR_io_uring_enter, fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR) {
+                throw_io_error(errno, "io_uring_enter failed");
+            }
+        }
+    }
+
+    bool fail() noexcept
+    {
+        close();
+        return false;
+    }
+
+    void close() noexcept
+    {
+        if (sqes_) ::munmap(sqes_, sqes_size_);
+        if (cq_map_ && cq_map_ != MAP_FAILED && cq_map_ != sq_map_) ::munmap(cq_map_, cq_map_size_);
+        if (sq_map_ && sq_map_ != MAP_FAILED) ::munmap(sq_map_, sq_map_size_);
+        if (fd_ >= 0) ::close(fd_);
+        sqes_ = nullptr;
+        cq_map_ = sq_map_ = nullptr;
+        fd_ = -1;
+    }
+
+    int fd_ = -1;
+    bool fixed_ = false;
+    unsigned unsubmitted_ = 0;
+    void* sq_map_ = nullptr;
+    void* cq_map_ = nullptr;
+    size_t sq_map_size_ = 0, cq_map_size_ = 0, sqes_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0, sq_entries_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+    std::deque<completion> reaped_;
+};
+
+#endif
+
+}
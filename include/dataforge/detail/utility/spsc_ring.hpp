@@ -0,0 +1,96 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace dataforge {
+
+#if defined(__cpp_lib_hardware_interference_size) && !defined(__GNUC__)
+inline constexpr size_t cache_line_size = std::hardware_destructive_interference_size;
+#else
+inline constexpr size_t cache_line_size = 64;
+#endif
+
+// Bounded lock-free queue of one producer thread and one consumer thread.
+// push() blocks while the ring is full and pop() while it is empty, which
+// gives the producer backpressure; the try_ forms never block.
+template <typename T>
+class spsc_ring
+{
+public:
+    explicit spsc_ring(size_t capacity)
+        : slots_{ std::make_unique<T[]>(capacity) }
+        , capacity_{ capacity }
+    {}
+
+    spsc_ring(spsc_ring const&) = delete;
+    spsc_ring& operator=(spsc_ring const&) = delete;
+
+    // producer side
+    bool try_push(T&& v)
+    {
+        size_t const tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == capacity_) return false;
+        publish(tail, std::move(v));
+        return true;
+    }
+
+    void push(T&& v)
+    {
+        size_t const tail = tail_.load(std::memory_order_relaxed);
+        for (size_t head; tail - (head = head_.load(std::memory_order_acquire)) == capacity_;) {
+            head_.wait(head, std::memory_order_acquire);
+        }
+        publish(tail, std::move(v));
+    }
+
+    // consumer side
+    bool try_pop(T& v)
+    {
+        size_t const head = head_.load(std::memory_order_relaxed);
+        if (tail_.load(std::memory_order_acquire) == head) return false;
+        v = consume(head);
+        return true;
+    }
+
+    T pop()
+    {
+        size_t const head = head_.load(std::memory_order_relaxed);
+        for (size_t tail; (tail = tail_.load(std::memory_order_acquire)) == head;) {
+            tail_.wait(tail, std::memory_order_acquire);
+        }
+        return consume(head);
+    }
+
+private:
+    void publish(size_t tail, T&& v)
+    {
+        slots_[tail % capacity_] = std::move(v);
+        tail_.store(tail + 1, std::memory_order_release);
+        tail_.notify_one();
+    }
+
+    T consume(size_t head)
+    {
+        T v = std::move(slots_[head % capacity_]);
+        head_.store(head + 1, std::memory_order_release);
+        head_.notify_one();
+        return v;
+    }
+
+    std::unique_ptr<T[]> slots_;
+    size_t capacity_;
+    alignas(cache_line_size) std::atomic<size_t> head_{ 0 };    // written by the consumer
+    alignas(cache_line_size) std::atomic<size_t> tail_{ 0 };    // written by the producer
+};
+
+}
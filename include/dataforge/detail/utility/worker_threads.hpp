@@ -0,0 +1,55 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <exception>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace dataforge {
+
+inline size_t hardware_worker_count() noexcept
+{
+    return (std::max)(std::thread::hardware_concurrency(), 1u);
+}
+
+// Calls fn(wi) for every wi in [0, worker_count): worker 0 runs on the calling
+// thread, the others on their own threads, all joined before returning. An
+// exception thrown by fn is rethrown after the join, the one of the lowest
+// worker first; so is a failure to start a thread.
+template <typename FnT>
+void run_on_workers(size_t worker_count, FnT const& fn)
+{
+    std::vector<std::exception_ptr> errors(worker_count);
+    auto guarded = [&fn, &errors](size_t wi) noexcept {
+        try {
+            fn(wi);
+        } catch (...) {
+            errors[wi] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(worker_count ? worker_count - 1 : 0);
+    try {
+        for (size_t wi = 1; wi < worker_count; ++wi) {
+            threads.emplace_back([&guarded, wi] { guarded(wi); });
+        }
+    } catch (...) {
+        for (std::thread& th : threads) th.join();
+        throw;
+    }
+    if (worker_count) guarded(size_t{ 0 });
+    for (std::thread& th : threads) th.join();
+    for (std::exception_ptr const& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+}
@@ -0,0 +1,357 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "detail/utility/consumer_traits.hpp"
+
+#if defined(_WIN32)
+#   include <fcntl.h>
+#   include <io.h>
+#   include <sys/stat.h>
+#else
+#   include <fcntl.h>
+#   include <sys/uio.h>
+#   include <unistd.h>
+#endif
+
+namespace dataforge {
+
+namespace fd_sink_detail {
+
+struct io_piece
+{
+    const void* data;
+    size_t size;
+};
+
+[[noreturn]] inline void throw_errno(const char* what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// writes the pieces completely, in as few calls as the system allows; done
+// counts the bytes written, also when a write fails
+inline void write_all(int fd, io_piece* pieces, size_t count, size_t& done)
+{
+#if defined(_WIN32)
+    for (size_t i = 0; i < count; ++i) {
+        auto const* p = static_cast<const char*>(pieces[i].data);
+        for (size_t left = pieces[i].size; left;) {
+            int const n = ::_write(fd, p, static_cast<unsigned>((std::min)(left, size_t{ 1 } << 30)));
+            if (n < 0) throw_errno("fd_sink: write failed");
+            p += n;
+            left -= static_cast<size_t>(n);
+            done += static_cast<size_t>(n);
+        }
+    }
+#else
+    iovec iov[2];
+    while (count) {
+        for (size_t i = 0; i < count; ++i) iov[i] = { const_cast<void*>(pieces[i].data), pieces[i].size };
+        ssize_t n = ::writev(fd, iov, static_cast<int>(count));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw_errno("fd_sink: write failed");
+        }
+        done += static_cast<size_t>(n);
+        // skip what was written
+        while (count && static_cast<size_t>(n) >= pieces[0].size) {
+            n -= static_cast<ssize_t>(pieces[0].size);
+            ++pieces;
+            --count;
+        }
+        if (count) {
+            pieces[0].data = static_cast<const char*>(pieces[0].data) + n;
+            pieces[0].size -= static_cast<size_t>(n);
+        }
+    }
+#endif
+}
+
+struct aligned_deleter
+{
+    void operator()(unsigned char* p) const noexcept
+    {
+#if defined(_WIN32)
+        ::_aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+};
+
+inline unsigned char* aligned_allocate(size_t alignment, size_t size)
+{
+#if defined(_WIN32)
+    void* p = ::_aligned_malloc(size, alignment);
+#else
+    void* p = nullptr;
+    if (::posix_memalign(&p, alignment, size) != 0) p = nullptr;
+#endif
+    if (!p) throw std::bad_alloc{};
+    return static_cast<unsigned char*>(p);
+}
+
+}
+
+// A consumer for push pipelines that writes to a file descriptor. Small
+// outputs are gathered in a staging buffer; an output of a quarter of the
+// buffer or more is written together with the staged bytes by one writev()
+// without copying. The buffer is written out when it fills up and on flush()
+// and finish(), which push_converter calls for its consumer.
+//     auto it = quark_push_iterator{ int8 | base64, fd_sink{ STDOUT_FILENO } };
+class fd_sink
+{
+public:
+    using consumer_category = flushing_consumer_tag;
+
+    explicit fd_sink(int fd, size_t buffer_bytes = 64 * 1024)
+        : fd_sink{ fd, buffer_bytes, 0 }
+    {}
+
+    fd_sink(fd_sink&& rhs) noexcept
+        : fd_{ std::exchange(rhs.fd_, -1) }
+        , capacity_{ rhs.capacity_ }
+        , passthrough_bytes_{ rhs.passthrough_bytes_ }
+        , alignment_{ rhs.alignment_ }
+        , buffer_{ std::move(rhs.buffer_) }
+        , size_{ std::exchange(rhs.size_, 0) }
+        , written_{ rhs.written_ }
+    {}
+
+    fd_sink& operator=(fd_sink&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            release();
+            fd_ = std::exchange(rhs.fd_, -1);
+            capacity_ = rhs.capacity_;
+            passthrough_bytes_ = rhs.passthrough_bytes_;
+            alignment_ = rhs.alignment_;
+            buffer_ = std::move(rhs.buffer_);
+            size_ = std::exchange(rhs.size_, 0);
+            written_ = rhs.written_;
+        }
+        return *this;
+    }
+
+    // the staged bytes are written, errors are ignored; call finish() to see them
+    ~fd_sink() { release(); }
+
+    template <typename DataT>
+    void operator()(DataT const& data)
+    {
+        if constexpr (requires { data.size_bytes(); }) {
+            write(data.data(), data.size_bytes());
+        } else {
+            static_assert(std::is_trivially_copyable_v<DataT>);
+            write(&data, sizeof(DataT));
+        }
+    }
+
+    void write(const void* data, size_t size)
+    {
+        if (size <= capacity_ - size_) {
+            std::memcpy(buffer_.get() + size_, data, size);
+            size_ += size;
+            if (size_ == capacity_) write_staged(capacity_);
+        } else if (size >= passthrough_bytes_ && !alignment_) {
+            fd_sink_detail::io_piece pieces[2] = { { buffer_.get(), size_ }, { data, size } };
+            size_t done = 0;
+            try {
+                fd_sink_detail::write_all(fd_, pieces + (size_ ? 0 : 1), size_ ? 2 : 1, done);
+            } catch (...) {
+                // the staged bytes that reached the file must not be written again
+                size_t const staged = (std::min)(done, size_);
+                drop_staged(staged);
+                written_ += done - staged;
+                throw;
+            }
+            written_ += size_ + size;
+            size_ = 0;
+        } else {
+            auto const* p = static_cast<const unsigned char*>(data);
+            while (size) {
+                size_t const n = (std::min)(size, capacity_ - size_);
+                std::memcpy(buffer_.get() + size_, p, n);
+                size_ += n;
+                p += n;
+                size -= n;
+                if (size_ == capacity_) write_staged(capacity_);
+            }
+        }
+    }
+
+    // writes the staged bytes; with O_DIRECT only the whole blocks
+    void flush()
+    {
+        write_staged(alignment_ ? size_ / alignment_ * alignment_ : size_);
+    }
+
+    void finish()
+    {
+        if (alignment_ && size_ % alignment_) {
+            flush();
+            finish_direct();
+        }
+        write_staged(size_);
+    }
+
+    int fd() const noexcept { return fd_; }
+    uint64_t bytes_written() const noexcept { return written_; }
+
+protected:
+    // a nonzero alignment is for O_DIRECT: the staging buffer and every write
+    // are aligned to it
+    fd_sink(int fd, size_t buffer_bytes, size_t alignment)
+        : fd_{ fd }
+        , capacity_{ alignment ? (std::max)((buffer_bytes + alignment - 1) / alignment * alignment, alignment) : (std::max)(buffer_bytes, size_t{ 1 }) }
+        , passthrough_bytes_{ capacity_ / 4 }
+        , alignment_{ alignment }
+        , buffer_{ fd_sink_detail::aligned_allocate(alignment ? alignment : alignof(std::max_align_t), capacity_) }
+    {}
+
+    // the last unaligned tail is written without O_DIRECT
+    void finish_direct()
+    {
+#if defined(O_DIRECT)
+        int const flags = ::fcntl(fd_, F_GETFL);
+        if (flags < 0 || ::fcntl(fd_, F_SETFL, flags & ~O_DIRECT) < 0) fd_sink_detail::throw_errno("fd_sink: fcntl failed");
+#endif
+        alignment_ = 0;
+    }
+
+    void release() noexcept
+    {
+        if (fd_ < 0 || !buffer_) return;
+        try {
+            finish();
+        } catch (...) {}
+    }
+
+    int fd_;
+
+private:
+    void write_staged(size_t n)
+    {
+        if (!n) return;
+        fd_sink_detail::io_piece piece{ buffer_.get(), n };
+        size_t done = 0;
+        try {
+            fd_sink_detail::write_all(fd_, &piece, 1, done);
+        } catch (...) {
+            drop_staged(done);
+            throw;
+        }
+        drop_staged(n);
+    }
+
+    // the first n staged bytes have been written
+    void drop_staged(size_t n) noexcept
+    {
+        std::memmove(buffer_.get(), buffer_.get() + n, size_ - n);
+        size_ -= n;
+        written_ += n;
+    }
+
+    size_t capacity_;
+    size_t passthrough_bytes_;
+    size_t alignment_ = 0;
+    std::unique_ptr<unsigned char, fd_sink_detail::aligned_deleter> buffer_;
+    size_t size_ = 0;
+    uint64_t written_ = 0;
+};
+
+struct file_sink_options
+{
+    size_t buffer_bytes = 256 * 1024;
+    bool append = false;
+    bool direct = false;        // O_DIRECT where available: bypass the page cache
+    size_t direct_alignment = 4096;
+};
+
+// fd_sink writing to a file it opens (created or truncated) and closes.
+// A file system that refuses O_DIRECT gets buffered writes.
+class file_sink : public fd_sink
+{
+    struct opened
+    {
+        int fd;
+        bool direct;
+    };
+
+public:
+    explicit file_sink(std::string const& path, file_sink_options const& opts = {})
+        : file_sink{ open(path, opts), opts }
+    {}
+
+    file_sink(file_sink&&) noexcept = default;
+    file_sink& operator=(file_sink&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            close();
+            fd_sink::operator=(std::move(rhs));
+        }
+        return *this;
+    }
+
+    ~file_sink() { close(); }
+
+    void close()
+    {
+        if (fd_ < 0) return;
+        release();
+#if defined(_WIN32)
+        ::_close(fd_);
+#else
+        ::close(fd_);
+#endif
+        fd_ = -1;
+    }
+
+private:
+    file_sink(opened f, file_sink_options const& opts)
+        : fd_sink{ f.fd, opts.buffer_bytes, f.direct ? opts.direct_alignment : 0 }
+    {}
+
+    static opened open(std::string const& path, file_sink_options const& opts)
+    {
+        bool direct = false;
+#if defined(_WIN32)
+        int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (opts.append ? _O_APPEND : _O_TRUNC);
+        int fd = ::_open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+        int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (opts.append ? O_APPEND : O_TRUNC);
+        int fd = -1;
+#   if defined(O_DIRECT)
+        if (opts.direct && !opts.append) {
+            fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+            direct = fd >= 0;
+        }
+#   endif
+        if (fd < 0) fd = ::open(path.c_str(), flags, 0644);
+#endif
+        if (fd < 0) throw std::runtime_error("file_sink: can't open " + path);
+        return { fd, direct };
+    }
+};
+
+}
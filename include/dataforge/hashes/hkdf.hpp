@@ -0,0 +1,56 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include "../detail/quarks.hpp"
+
+namespace dataforge {
+
+template <typename DigestQuarkT>
+struct hkdf_qrk : cvt_qrk<void>
+{
+    DigestQuarkT digest;
+    cbyte_span_t salt;
+    cbyte_span_t info;
+    size_t length;
+
+    template <SpanOfIntegrals<8> ST, SpanOfIntegrals<8> IT>
+    hkdf_qrk(DigestQuarkT const& digest_val, ST salt_val, IT info_val, size_t length_val)
+        : digest{ digest_val }
+        , salt{ reinterpret_cast<const unsigned char*>(salt_val.data()), salt_val.size() }
+        , info{ reinterpret_cast<const unsigned char*>(info_val.data()), info_val.size() }
+        , length{ length_val }
+    {}
+};
+
+// hkdf(sha256, salt, info, length): extract-and-expand key derivation
+// (RFC 5869); the input is the input keying material, the output is a
+// length-byte key, at most 255 digest lengths long. salt and info are
+// copied by the converters, so they only have to outlive the quark.
+template <typename DigestStartT, typename DigestFinishT, SpanConvertible SaltT, SpanConvertible InfoT>
+inline auto hkdf(compound_qrk<DigestStartT, DigestFinishT> const& digest, SaltT&& salt, InfoT&& info, size_t length)
+{
+    return compound_qrk<hkdf_qrk<DigestStartT>, DigestFinishT>(
+        hkdf_qrk<DigestStartT>{ digest.start, std::span{ std::forward<SaltT>(salt) }, std::span{ std::forward<InfoT>(info) }, length },
+        nullptr
+    );
+}
+
+}
+
+#include "../detail/hashes/hkdf_pusher.hpp"
+
+namespace dataforge {
+
+template <IntegralBasedQuark<8> FromQuarkT, typename DigestQuarkT>
+struct cvt_resolver<FromQuarkT, hkdf_qrk<DigestQuarkT>>
+{
+    using type = hkdf_pusher<typename cvt_resolver<FromQuarkT, DigestQuarkT>::type>;
+};
+
+}
@@ -0,0 +1,51 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include "../detail/quarks.hpp"
+
+namespace dataforge {
+
+template <typename DigestQuarkT>
+struct hmac_qrk : cvt_qrk<void>
+{
+    DigestQuarkT digest;
+    cbyte_span_t key;
+
+    template <SpanOfIntegrals<8> KT>
+    hmac_qrk(DigestQuarkT const& digest_val, KT key_val)
+        : digest{ digest_val }
+        , key{ reinterpret_cast<const unsigned char*>(key_val.data()), key_val.size() }
+    {}
+};
+
+// hmac(sha256, key): keyed digest for any hash quark from dataforge/hashes.
+// The key is referenced, not copied; it must outlive the quark, but not the
+// converters built from it.
+template <typename DigestStartT, typename DigestFinishT, SpanConvertible KeyT>
+inline auto hmac(compound_qrk<DigestStartT, DigestFinishT> const& digest, KeyT&& key)
+{
+    return compound_qrk<hmac_qrk<DigestStartT>, DigestFinishT>(
+        hmac_qrk<DigestStartT>{ digest.start, std::span{ std::forward<KeyT>(key) } },
+        nullptr
+    );
+}
+
+}
+
+#include "../detail/hashes/hmac_pusher.hpp"
+
+namespace dataforge {
+
+template <IntegralBasedQuark<8> FromQuarkT, typename DigestQuarkT>
+struct cvt_resolver<FromQuarkT, hmac_qrk<DigestQuarkT>>
+{
+    using type = hmac_pusher<typename cvt_resolver<FromQuarkT, DigestQuarkT>::type>;
+};
+
+}
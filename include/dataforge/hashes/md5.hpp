@@ -29,3 +29,11 @@ struct cvt_resolver<FromQuarkT, md5_qrk>
 };
 
 }
+
+#include "../detail/hashes/digest_ops.hpp"
+
+namespace dataforge {
+
+template <size_t N> inline auto md5_fixed(const void* data) { return digest_fixed<N>(md5, data); }
+
+}
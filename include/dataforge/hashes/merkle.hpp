@@ -0,0 +1,42 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include "../detail/quarks.hpp"
+#include "../detail/hashes/merkle_pusher.hpp"
+
+namespace dataforge {
+
+template <typename DigestQuarkT>
+struct merkle_qrk : cvt_qrk<void>
+{
+    DigestQuarkT digest;
+    size_t chunk_size;
+    size_t arity;
+    merkle_output output;
+};
+
+// merkle(sha256, chunk_size, arity, output): root of the arity-ary hash tree
+// over chunk_size-byte chunks of the input, optionally preceded by the leaf
+// (chunk) digests in input order; see merkle_pusher for the tree shape.
+template <typename DigestStartT, typename DigestFinishT>
+inline auto merkle(compound_qrk<DigestStartT, DigestFinishT> const& digest, size_t chunk_size, size_t arity = 2, merkle_output output = merkle_output::root)
+{
+    return compound_qrk<merkle_qrk<DigestStartT>, DigestFinishT>(
+        merkle_qrk<DigestStartT>{ {}, digest.start, chunk_size, arity, output },
+        nullptr
+    );
+}
+
+template <IntegralBasedQuark<8> FromQuarkT, typename DigestQuarkT>
+struct cvt_resolver<FromQuarkT, merkle_qrk<DigestQuarkT>>
+{
+    using type = merkle_pusher<typename cvt_resolver<FromQuarkT, DigestQuarkT>::type>;
+};
+
+}
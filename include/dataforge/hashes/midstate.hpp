@@ -0,0 +1,95 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "../detail/quarks.hpp"
+#include "../detail/hashes/digest_state.hpp"
+#include "../quark_push_iterator.hpp"
+
+namespace dataforge {
+
+template <typename DigestQuarkT, typename StateT>
+struct midstate_qrk : cvt_qrk<void>
+{
+    DigestQuarkT digest;
+    StateT state;
+
+    midstate_qrk(DigestQuarkT const& digest_val, StateT const& state_val)
+        : digest{ digest_val }, state{ state_val }
+    {}
+};
+
+// from_midstate(sha256, st): the digest starts from a snapshot taken by
+// snapshot() and comes back to it after every finish(), e.g. to hash many
+// documents behind a common header without rehashing the header.
+// The state must come from a converter of the same digest and kind: a plain
+// sha256 snapshot doesn't compile with from_midstate(hmac(sha256, key), ...).
+template <typename DigestStartT, typename DigestFinishT, typename StateT, typename KindT>
+inline auto from_midstate(compound_qrk<DigestStartT, DigestFinishT> const& digest, digest_state<StateT, KindT> const& state)
+{
+    return compound_qrk<midstate_qrk<DigestStartT, digest_state<StateT, KindT>>, DigestFinishT>(
+        midstate_qrk<DigestStartT, digest_state<StateT, KindT>>{ digest.start, state },
+        nullptr
+    );
+}
+
+namespace midstate_detail {
+
+template <typename CvtTupleT, size_t I = 0>
+constexpr size_t digest_stage_index()
+{
+    static_assert(I < std::tuple_size_v<CvtTupleT>, "the pipeline has no digest stage");
+    if constexpr (requires (std::tuple_element_t<I, CvtTupleT> const& cvt) { cvt.snapshot(); }) {
+        return I;
+    } else {
+        return digest_stage_index<CvtTupleT, I + 1>();
+    }
+}
+
+template <typename ConverterT>
+inline auto& digest_stage(ConverterT const& cvt)
+{
+    using cvt_tuple_t = std::remove_cvref_t<decltype(cvt.chain())>;
+    return std::get<digest_stage_index<cvt_tuple_t>()>(cvt.chain());
+}
+
+template <typename ConverterT>
+using digest_stage_state_t = typename std::remove_cvref_t<decltype(digest_stage(std::declval<ConverterT const&>()))>::state_type;
+
+}
+
+// Midstate of the first digest stage of a push pipeline.
+template <typename ConverterT>
+inline auto snapshot(quark_push_iterator<ConverterT> const& it)
+{
+    return midstate_detail::digest_stage(it.converter()).snapshot();
+}
+
+// Replaces the state of the first digest stage of a push pipeline with one
+// taken from a converter of the same digest and kind.
+template <typename ConverterT, typename StateT, typename KindT>
+requires(std::is_same_v<digest_state<StateT, KindT>, midstate_detail::digest_stage_state_t<ConverterT>>)
+inline void restore(quark_push_iterator<ConverterT>& it, digest_state<StateT, KindT> const& state)
+{
+    midstate_detail::digest_stage(it.converter()).restore(state);
+}
+
+}
+
+namespace dataforge {
+
+template <IntegralBasedQuark<8> FromQuarkT, typename DigestQuarkT, typename StateT>
+struct cvt_resolver<FromQuarkT, midstate_qrk<DigestQuarkT, StateT>>
+{
+    using type = midstate_pusher<typename cvt_resolver<FromQuarkT, DigestQuarkT>::type>;
+};
+
+}
@@ -0,0 +1,56 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include "../detail/quarks.hpp"
+
+namespace dataforge {
+
+template <typename DigestQuarkT>
+struct pbkdf2_qrk : cvt_qrk<void>
+{
+    DigestQuarkT digest;
+    cbyte_span_t salt;
+    size_t iterations;
+    size_t length;
+
+    template <SpanOfIntegrals<8> ST>
+    pbkdf2_qrk(DigestQuarkT const& digest_val, ST salt_val, size_t iterations_val, size_t length_val)
+        : digest{ digest_val }
+        , salt{ reinterpret_cast<const unsigned char*>(salt_val.data()), salt_val.size() }
+        , iterations{ iterations_val }
+        , length{ length_val }
+    {}
+};
+
+// pbkdf2(sha256, salt, iterations, length): password-based key derivation
+// with HMAC over any hash quark from dataforge/hashes; the input is the
+// password, the output is a length-byte key. The salt is copied by the
+// converters, so it only has to outlive the quark.
+template <typename DigestStartT, typename DigestFinishT, SpanConvertible SaltT>
+inline auto pbkdf2(compound_qrk<DigestStartT, DigestFinishT> const& digest, SaltT&& salt, size_t iterations, size_t length)
+{
+    return compound_qrk<pbkdf2_qrk<DigestStartT>, DigestFinishT>(
+        pbkdf2_qrk<DigestStartT>{ digest.start, std::span{ std::forward<SaltT>(salt) }, iterations, length },
+        nullptr
+    );
+}
+
+}
+
+#include "../detail/hashes/pbkdf2_pusher.hpp"
+
+namespace dataforge {
+
+template <IntegralBasedQuark<8> FromQuarkT, typename DigestQuarkT>
+struct cvt_resolver<FromQuarkT, pbkdf2_qrk<DigestQuarkT>>
+{
+    using type = pbkdf2_pusher<typename cvt_resolver<FromQuarkT, DigestQuarkT>::type>;
+};
+
+}
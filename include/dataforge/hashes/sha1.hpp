@@ -28,3 +28,11 @@ struct cvt_resolver<FromQuarkT, sha_qrk<sha1_type, sha1_type::sha1>>
 };
 
 }
+
+#include "../detail/hashes/digest_ops.hpp"
+
+namespace dataforge {
+
+template <size_t N> inline auto sha1_fixed(const void* data) { return digest_fixed<N>(sha1, data); }
+
+}
@@ -33,3 +33,15 @@ struct cvt_resolver<FromQuarkT, sha_qrk<sha2_type, TypeV>>
 };
 
 }
+
+#include "../detail/hashes/digest_ops.hpp"
+
+namespace dataforge {
+
+// sha256_fixed<64>(p): digest of exactly N bytes, e.g. a Merkle node
+template <size_t N> inline auto sha224_fixed(const void* data) { return digest_fixed<N>(sha224, data); }
+template <size_t N> inline auto sha256_fixed(const void* data) { return digest_fixed<N>(sha256, data); }
+template <size_t N> inline auto sha384_fixed(const void* data) { return digest_fixed<N>(sha384, data); }
+template <size_t N> inline auto sha512_fixed(const void* data) { return digest_fixed<N>(sha512, data); }
+
+}
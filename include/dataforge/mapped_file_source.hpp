@@ -0,0 +1,249 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace dataforge {
+
+struct mapped_file_options
+{
+    size_t window_bytes = size_t{ 64 } << 20;       // the size of the spans handed out
+    uint64_t max_mapped_bytes = uint64_t{ 1 } << 30; // larger files are mapped window by window
+    bool populate = false;                          // prefault the mapping (MAP_POPULATE)
+    bool huge_pages = false;                        // ask for transparent huge pages (MADV_HUGEPAGE)
+};
+
+// A file read through memory mappings, a source for pull converters:
+//     mapped_file_source src{ "data.bin" };
+//     auto it = quark_pull_iterator{ int8 | sha256, std::ref(src) };
+// next() returns the following page-aligned window of the file, an empty span
+// at the end. A file up to max_mapped_bytes is mapped at once and its windows
+// stay valid while the source lives; a larger one is mapped one window at a
+// time, and next() unmaps the previous window.
+class mapped_file_source
+{
+public:
+    explicit mapped_file_source(std::string const& path, mapped_file_options const& opts = {})
+        : opts_{ opts }
+    {
+        open(path);
+        size_t const granularity = allocation_granularity();
+        opts_.window_bytes = (std::max)((opts_.window_bytes + granularity - 1) / granularity * granularity, granularity);
+        whole_ = size_ <= opts_.max_mapped_bytes;
+        if (whole_ && size_) {
+            try {
+                map(0, static_cast<size_t>(size_));
+            } catch (...) {
+                close();
+                throw;
+            }
+        }
+    }
+
+    mapped_file_source(mapped_file_source const&) = delete;
+    mapped_file_source& operator=(mapped_file_source const&) = delete;
+
+    mapped_file_source(mapped_file_source&& rhs) noexcept
+        : opts_{ rhs.opts_ }, size_{ rhs.size_ }, offset_{ rhs.offset_ }, whole_{ rhs.whole_ }
+        , file_{ std::exchange(rhs.file_, invalid_file) }
+#if defined(_WIN32)
+        , mapping_{ std::exchange(rhs.mapping_, nullptr) }
+#endif
+        , view_{ std::exchange(rhs.view_, nullptr) }, view_offset_{ rhs.view_offset_ }, view_size_{ std::exchange(rhs.view_size_, 0) }
+    {}
+
+    mapped_file_source& operator=(mapped_file_source&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            close();
+            opts_ = rhs.opts_;
+            size_ = rhs.size_;
+            offset_ = rhs.offset_;
+            whole_ = rhs.whole_;
+            file_ = std::exchange(rhs.file_, invalid_file);
+#if defined(_WIN32)
+            mapping_ = std::exchange(rhs.mapping_, nullptr);
+#endif
+            view_ = std::exchange(rhs.view_, nullptr);
+            view_offset_ = rhs.view_offset_;
+            view_size_ = std::exchange(rhs.view_size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file_source() { close(); }
+
+    std::span<const unsigned char> next()
+    {
+        if (offset_ >= size_) return {};
+        size_t const n = static_cast<size_t>((std::min)(uint64_t{ opts_.window_bytes }, size_ - offset_));
+        if (!whole_) {
+            unmap();
+            map(offset_, n);
+        }
+        auto const* data = static_cast<const unsigned char*>(view_) + (offset_ - view_offset_);
+        offset_ += n;
+        return { data, n };
+    }
+
+    // starts over from the beginning of the file
+    void rewind() noexcept { offset_ = 0; }
+
+    uint64_t size() const noexcept { return size_; }
+
+private:
+#if defined(_WIN32)
+    using file_t = HANDLE;
+    static inline const file_t invalid_file = INVALID_HANDLE_VALUE;
+
+    static size_t allocation_granularity() noexcept
+    {
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        return si.dwAllocationGranularity;
+    }
+
+    void open(std::string const& path)
+    {
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("mapped_file_source: can't open " + path);
+        }
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file_, &sz)) {
+            close();
+            throw std::runtime_error("mapped_file_source: can't get the size of " + path);
+        }
+        size_ = static_cast<uint64_t>(sz.QuadPart);
+        if (size_) {
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping_) {
+                close();
+                throw std::runtime_error("mapped_file_source: can't map " + path);
+            }
+        }
+    }
+
+    void map(uint64_t offset, size_t n)
+    {
+        view_ = MapViewOfFile(mapping_, FILE_MAP_READ, static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset), n);
+        if (!view_) throw std::runtime_error("mapped_file_source: MapViewOfFile failed");
+        if (opts_.populate) {
+            WIN32_MEMORY_RANGE_ENTRY range{ view_, n };
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+        view_offset_ = offset;
+        view_size_ = n;
+    }
+
+    void unmap() noexcept
+    {
+        if (view_) UnmapViewOfFile(view_);
+        view_ = nullptr;
+        view_size_ = 0;
+    }
+
+    void close() noexcept
+    {
+        unmap();
+        if (mapping_) CloseHandle(mapping_);
+        mapping_ = nullptr;
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+    }
+#else
+    using file_t = int;
+    static constexpr file_t invalid_file = -1;
+
+    static size_t allocation_granularity() noexcept
+    {
+        long const page = ::sysconf(_SC_PAGESIZE);
+        return page > 0 ? static_cast<size_t>(page) : 4096;
+    }
+
+    void open(std::string const& path)
+    {
+        file_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file_ < 0) {
+            throw std::runtime_error("mapped_file_source: can't open " + path);
+        }
+        struct stat st;
+        if (::fstat(file_, &st) != 0) {
+            close();
+            throw std::runtime_error("mapped_file_source: can't get the size of " + path);
+        }
+        size_ = static_cast<uint64_t>(st.st_size);
+    }
+
+    void map(uint64_t offset, size_t n)
+    {
+        int flags = MAP_PRIVATE;
+#   if defined(MAP_POPULATE)
+        if (opts_.populate) flags |= MAP_POPULATE;
+#   endif
+        void* p = ::mmap(nullptr, n, PROT_READ, flags, file_, static_cast<off_t>(offset));
+        if (p == MAP_FAILED) throw std::runtime_error("mapped_file_source: mmap failed");
+        ::madvise(p, n, MADV_SEQUENTIAL);
+#   if defined(MADV_HUGEPAGE)
+        if (opts_.huge_pages) ::madvise(p, n, MADV_HUGEPAGE);
+#   endif
+        view_ = p;
+        view_offset_ = offset;
+        view_size_ = n;
+    }
+
+    void unmap() noexcept
+    {
+        if (view_) ::munmap(view_, view_size_);
+        view_ = nullptr;
+        view_size_ = 0;
+    }
+
+    void close() noexcept
+    {
+        unmap();
+        if (file_ >= 0) ::close(file_);
+        file_ = -1;
+    }
+#endif
+
+    mapped_file_options opts_;
+    uint64_t size_ = 0;
+    uint64_t offset_ = 0;
+    bool whole_ = true;
+    file_t file_ = invalid_file;
+#if defined(_WIN32)
+    HANDLE mapping_ = nullptr;
+#endif
+    void* view_ = nullptr;
+    uint64_t view_offset_ = 0;
+    size_t view_size_ = 0;
+};
+
+}
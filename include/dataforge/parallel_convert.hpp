@@ -0,0 +1,131 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "convert.hpp"
+#include "detail/utility/worker_threads.hpp"
+
+namespace dataforge {
+
+template <typename ConverterT>
+concept ChunkIndependentConverter = requires(ConverterT const& c) {
+    { c.chunk_alignment() } -> std::convertible_to<chunk_independence>;
+};
+
+// The chunk independence of a whole chain: input pieces of input_block
+// elements reach every stage aligned to its own input_block. Empty when a
+// stage can't be split.
+template <typename CvtTupleT>
+chunk_independence chain_chunk_alignment(CvtTupleT const& stages) noexcept
+{
+    chunk_independence result{ 1, 1 };
+    auto compose = [&result](auto const& stage) {
+        if constexpr (ChunkIndependentConverter<std::remove_cvref_t<decltype(stage)>>) {
+            if (!result) return;
+            chunk_independence const a = stage.chunk_alignment();
+            if (!a || !a.output_block) {
+                result = {};
+                return;
+            }
+            // the smallest multiple of the output so far the stage accepts
+            size_t const k = a.input_block / std::gcd(result.output_block, a.input_block);
+            result = { result.input_block * k, result.output_block * k / a.input_block * a.output_block };
+        } else {
+            result = {};
+        }
+    };
+    std::apply([&compose](auto const& ... stage) { (compose(stage), ...); }, stages);
+    return result;
+}
+
+// Converts a contiguous input with a chain on several threads and returns the
+// output. When every stage reports a chunk_alignment(), the input is cut into
+// aligned pieces of at least min_chunk_bytes, the worker threads take the
+// pieces one by one and write the outputs into their places in the result.
+// Other chains, small inputs and threads <= 1 convert on the calling thread.
+template <typename CvtTupleT, typename ... Quarks, typename InputT>
+auto parallel_convert(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, InputT const& input,
+    size_t threads = hardware_worker_count(), size_t min_chunk_bytes = 1024 * 1024)
+{
+    using input_element_type = typename std::tuple_element_t<0, CvtTupleT>::input_element_type;
+    using output_element_type = std::remove_const_t<typename std::tuple_element_t<std::tuple_size_v<CvtTupleT> - 1, CvtTupleT>::output_element_type>;
+    using result_t = std::vector<output_element_type>;
+
+    auto const in = span_cast<const input_element_type>(std::span{ input });
+
+    auto convert_sequentially = [&chain](std::span<const input_element_type> data) {
+        result_t result;
+        push_converter<CvtTupleT, std::back_insert_iterator<result_t>> cvt{ chain, std::back_inserter(result) };
+        cvt.push(data);
+        cvt.finish();
+        return result;
+    };
+
+    chunk_independence const alignment = chain_chunk_alignment(*cvt_tuple_wrapper<CvtTupleT>{ chain });
+    if (!alignment || threads <= 1) {
+        return convert_sequentially(in);
+    }
+
+    size_t chunk = (std::max)(min_chunk_bytes / sizeof(input_element_type), in.size() / (threads * 4));
+    chunk = (std::max)(chunk / alignment.input_block, size_t{ 1 }) * alignment.input_block;
+    size_t const chunk_count = in.size() / chunk;
+    if (chunk_count < 2) {
+        return convert_sequentially(in);
+    }
+
+    // the last piece takes the remainder; it is converted into its own
+    // buffer, as only the aligned pieces have a known output size
+    size_t const chunk_output = chunk / alignment.input_block * alignment.output_block;
+    result_t result((chunk_count - 1) * chunk_output);
+    result_t tail;
+
+    std::atomic<size_t> next_chunk{ 0 };
+    std::atomic<bool> failed{ false };
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    run_on_workers((std::min)(threads, chunk_count), [&](size_t) {
+        for (size_t ci; !failed.load(std::memory_order_relaxed) && (ci = next_chunk.fetch_add(1, std::memory_order_relaxed)) < chunk_count;) {
+            try {
+                auto const piece = in.subspan(ci * chunk, ci + 1 < chunk_count ? chunk : std::dynamic_extent);
+                if (ci + 1 == chunk_count) {
+                    tail = convert_sequentially(piece);
+                    continue;
+                }
+                output_element_type* const place = result.data() + ci * chunk_output;
+                using writer_t = convert_detail::span_writer<output_element_type>;
+                push_converter<CvtTupleT, writer_t> cvt{ chain, writer_t{ place, place + chunk_output } };
+                cvt.push(piece);
+                cvt.finish();
+                if (cvt.consumer().pos != cvt.consumer().end) {
+                    throw std::runtime_error("parallel_convert: a stage broke its chunk alignment");
+                }
+            } catch (...) {
+                std::lock_guard lock{ error_mutex };
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        }
+    });
+    if (error) std::rethrow_exception(error);
+
+    result.insert(result.end(), tail.begin(), tail.end());
+    return result;
+}
+
+}
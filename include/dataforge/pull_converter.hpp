@@ -7,25 +7,40 @@
 ==============================================================================*/
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <tuple>
 #include <type_traits>
 #include <memory>
 #include <bitset>
+#include <vector>
 
 #include "detail/quarks.hpp"
 #include "detail/utility/concepts.hpp"
+#include "detail/utility/instrumentation.hpp"
 
 namespace dataforge {
 
 template <typename ET, typename DataProviderT> struct last_provider;
 
+// Contiguous iterators hand out the whole range, and the contiguous runs of
+// other random access ones (deque blocks) are handed out without a copy; the
+// rest of a random access range is gathered into blocks of about 4 KB, so
+// that the chain runs once per block rather than once per element. Other
+// iterators (lists) hand out one element at a time: a gathered copy would
+// cost more than it saves for the stages that take elements one by one.
 template <typename ET, typename IteatorT>
 requires(is_compatible_span_v<std::span<typename std::iterator_traits<IteatorT>::value_type>, ET>)
 struct last_provider<ET, IteatorT>
 {
+    static constexpr size_t block_elements = (std::max)(4096 / sizeof(ET), size_t{ 1 });
+
     IteatorT first;
     IteatorT last;
+    std::vector<ET> block;
     ET value;
+
     explicit last_provider(IteatorT f, IteatorT l)
         : first{ std::move(f) }
         , last{ std::move(l) }
@@ -33,11 +48,30 @@ struct last_provider<ET, IteatorT>
 
     inline std::span<const ET> operator()()
     {
-        if (first != last) {
+        if (first == last) return {};
+        if constexpr (std::contiguous_iterator<IteatorT>) {
+            auto const result = span_cast<const ET>(std::span{ std::to_address(first), static_cast<size_t>(last - first) });
+            first = last;
+            return result;
+        } else if constexpr (!std::random_access_iterator<IteatorT>) {
             value = *first; ++first;
             return std::span{ &value, 1 };
+        } else {
+            if constexpr (std::is_lvalue_reference_v<std::iter_reference_t<IteatorT>>) {
+                auto* const p = std::addressof(*first);
+                auto it = std::next(first);
+                size_t n = 1;
+                for (; n < block_elements && it != last && std::addressof(*it) == p + n; ++it) ++n;
+                if (n > 1) {
+                    first = std::move(it);
+                    return span_cast<const ET>(std::span{ p, n });
+                }
+            }
+            block.resize(block_elements);
+            size_t n = 0;
+            for (; n < block_elements && first != last; ++n, ++first) block[n] = *first;
+            return { block.data(), n };
         }
-        return {};
     }
 };
 
@@ -131,6 +165,22 @@ struct last_provider<ET, RangeT> : last_provider<ET, decltype(std::declval<const
     }
 };
 
+// a source object handing out its data piece by piece by next(), e.g.
+// mapped_file_source; it is passed by std::ref and stays owned by the caller
+template <typename ET, typename SourceT>
+requires(requires(SourceT& s) { span_cast<const ET>(s.next()); })
+struct last_provider<ET, std::reference_wrapper<SourceT>>
+{
+    std::reference_wrapper<SourceT> source;
+
+    explicit last_provider(std::reference_wrapper<SourceT> s) : source{ s } {}
+
+    inline std::span<const ET> operator()()
+    {
+        return span_cast<const ET>(source.get().next());
+    }
+};
+
 template <typename ConverterT, size_t I = ConverterT::chain_size - 1>
 struct slice_pull_converter
 {
@@ -144,17 +194,21 @@ struct slice_pull_converter
     {
         if (!cvt_.eof_flags.test(I)) {
             std::span<const output_element_type> r;
-            if constexpr (I > 0) {
-                r = std::get<I>(cvt_.chain()).pull(
-                    std::get<I>(cvt_.inputs),
-                    slice_pull_converter<ConverterT, I - 1>(cvt_)
-                );
-            } else {
-                r = std::get<0>(cvt_.chain()).pull(
-                    std::get<0>(cvt_.inputs),
-                    std::ref(cvt_.provider)
-                );
+            {
+                [[maybe_unused]] auto scope = cvt_.instrumentation().stage_scope(I);
+                if constexpr (I > 0) {
+                    r = std::get<I>(cvt_.chain()).pull(
+                        std::get<I>(cvt_.inputs),
+                        cvt_.instrumentation().template provider<I>(slice_pull_converter<ConverterT, I - 1>(cvt_))
+                    );
+                } else {
+                    r = std::get<0>(cvt_.chain()).pull(
+                        std::get<0>(cvt_.inputs),
+                        cvt_.instrumentation().template provider<0>(std::ref(cvt_.provider))
+                    );
+                }
             }
+            cvt_.instrumentation().count_output(I, r);
             if (!r.empty()) return r;
             cvt_.eof_flags.set(I);
         }
@@ -175,10 +229,12 @@ struct slice_pull_converter
 template <typename T> struct span_tuple;
 template <typename ... Ts> struct span_tuple<std::tuple<Ts...>> { using type = std::tuple<std::span<const typename Ts::input_element_type> ...>; };
 
-template <typename CvtTupleT, typename BaseIteratorT>
+// InstrumentationT: see push_converter
+template <typename CvtTupleT, typename BaseIteratorT, typename InstrumentationT = no_instrumentation>
 class pull_converter
 {
     mutable cvt_tuple_wrapper<CvtTupleT> cvt_tuple_;
+    DATAFORGE_NO_UNIQUE_ADDRESS mutable instrumentation_state<InstrumentationT, std::tuple_size_v<CvtTupleT>> instrumentation_;
     
 public:
     using cvt_tuple_type = CvtTupleT;
@@ -199,6 +255,16 @@ public:
         , provider{ range }
     {}
 
+    template <typename ... Quarks>
+    pull_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, BaseIteratorT first, BaseIteratorT last, InstrumentationT)
+        : pull_converter{ chain, std::move(first), std::move(last) }
+    {}
+
+    template <typename ... Quarks>
+    pull_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, BaseIteratorT const& range, InstrumentationT)
+        : pull_converter{ chain, range }
+    {}
+
     auto pull()
     {
         return slice_pull_converter{*this}();
@@ -212,7 +278,19 @@ public:
         eof_flags.reset();
     }
 
+    // per-stage counters accumulated since construction or reset_stats()
+    pipeline_stats<chain_size> stats() const noexcept requires(InstrumentationT::enabled)
+    {
+        return instrumentation_.stats();
+    }
+
+    void reset_stats() noexcept requires(InstrumentationT::enabled)
+    {
+        instrumentation_.reset();
+    }
+
     inline CvtTupleT& chain() const { return *cvt_tuple_; }
+    inline auto& instrumentation() const noexcept { return instrumentation_; }
     
     // intermediate not handled inputs for each converter in the chain for pull operation  
     // a converter in the chain is responsible for filling its own input span
@@ -228,6 +306,12 @@ pull_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, RangeT const&)-
 template <typename CvtTupleT, typename ... Quarks, typename IteratorT>
 pull_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, IteratorT, IteratorT) -> pull_converter<CvtTupleT, IteratorT>;
 
+template <typename CvtTupleT, typename ... Quarks, typename RangeT, InstrumentationPolicy InstrumentationT>
+pull_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, RangeT const&, InstrumentationT)-> pull_converter<CvtTupleT, RangeT, InstrumentationT>;
+
+template <typename CvtTupleT, typename ... Quarks, typename IteratorT, InstrumentationPolicy InstrumentationT>
+pull_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, IteratorT, IteratorT, InstrumentationT) -> pull_converter<CvtTupleT, IteratorT, InstrumentationT>;
+
 
 template <typename ET>
 struct polymorphic_pull_converter
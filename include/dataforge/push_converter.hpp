@@ -7,14 +7,52 @@
 ==============================================================================*/
 #pragma once
 
+#include <algorithm>
+#include <iterator>
 #include <tuple>
 #include <type_traits>
 #include <memory>
 
 #include "detail/quarks.hpp"
+#include "detail/utility/execution.hpp"
+#include "detail/utility/consumer_traits.hpp"
 
 namespace dataforge {
 
+// the container behind a back_insert_iterator, to append a whole span at once
+template <typename ContainerT>
+inline ContainerT& back_insert_container(std::back_insert_iterator<ContainerT>& it) noexcept
+{
+    struct accessor : std::back_insert_iterator<ContainerT>
+    {
+        static ContainerT& get(std::back_insert_iterator<ContainerT>& i) noexcept { return *(i.*&accessor::container); }
+    };
+    return accessor::get(it);
+}
+
+namespace push_converter_detail {
+
+template <typename T>
+inline constexpr bool is_standard_integer_v = std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+    !std::is_same_v<T, char> && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t> &&
+    !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+// AccessT may read objects of type ObjectT without breaking strict aliasing:
+// AccessT is char or unsigned char, or the two are the same standard integer
+// type up to signedness
+template <typename AccessT, typename ObjectT>
+inline constexpr bool may_alias_v = std::is_same_v<AccessT, ObjectT> ||
+    std::is_same_v<AccessT, char> || std::is_same_v<AccessT, unsigned char> ||
+    [] {
+        if constexpr (is_standard_integer_v<AccessT> && is_standard_integer_v<ObjectT>) {
+            return std::is_same_v<std::make_unsigned_t<AccessT>, std::make_unsigned_t<ObjectT>>;
+        } else {
+            return false;
+        }
+    }();
+
+}
+
 template <typename IteatorT>
 struct last_consumer
 {
@@ -34,6 +72,30 @@ struct last_consumer
             base(val);
         }) {
             base(val);
+        } else if constexpr (requires { back_insert_container(base).insert(back_insert_container(base).end(), std::begin(val), std::end(val)); }) {
+            // a span is appended at once, e.g. bytes into a std::string by a
+            // single memcpy; a few elements are cheaper to push one by one
+            auto& c = back_insert_container(base);
+            using value_t = typename std::remove_cvref_t<decltype(c)>::value_type;
+            using element_t = std::remove_cvref_t<decltype(*std::begin(val))>;
+            if constexpr (requires { std::size(val); }) {
+                if (std::size(val) < 16) {
+                    for (auto d : val) c.push_back(d);
+                    return;
+                }
+            }
+            // the elements are read as value_t in place only where that is a
+            // permitted alias; other pairs are converted one by one
+            if constexpr (std::is_integral_v<value_t> && std::is_integral_v<element_t> && sizeof(value_t) == sizeof(element_t) &&
+                push_converter_detail::may_alias_v<value_t, element_t> &&
+                requires { std::data(val); std::size(val); }) {
+                auto const* p = reinterpret_cast<const value_t*>(std::data(val));
+                c.insert(c.end(), p, p + std::size(val));
+            } else {
+                c.insert(c.end(), std::begin(val), std::end(val));
+            }
+        } else if constexpr (std::is_pointer_v<IteatorT>) {
+            base = std::copy(std::begin(val), std::end(val), base);
         } else {
             for (auto d : val) {
                 *base = d;
@@ -43,52 +105,80 @@ struct last_consumer
     }
 };
 
+template <typename ConverterT, size_t I> struct chunking_consumer;
+
 template <typename ConverterT, size_t I = 0>
 struct slice_push_converter
 {
     ConverterT & cvt_;
     explicit slice_push_converter(ConverterT & cvt) noexcept : cvt_ { cvt } {}
 
-    template <typename DataT>
-    void operator()(DataT data)
-    {
+    // stage I collects its output into a chunk (stage-major execution only)
+    static constexpr bool chunked = []{
         if constexpr (I + 1 < ConverterT::chain_size) {
-            std::get<I>(cvt_.chain()).push(
-                std::move(data),
-                slice_push_converter<ConverterT, I + 1>(cvt_)
-            );
+            return requires(ConverterT& c, slice_push_converter<ConverterT, I + 1> s) {
+                { c.template stage_chunk<I>().span() };
+                std::get<I + 1>(c.chain()).push(c.template stage_chunk<I>().span(), s.next());
+            };
+        } else {
+            return false;
+        }
+    }();
+
+    // the consumer of stage I: the next stage or the output iterator
+    auto next() const
+    {
+        if constexpr (chunked) {
+            return cvt_.instrumentation().template consumer<I>(chunking_consumer<ConverterT, I>{ cvt_ });
+        } else if constexpr (I + 1 < ConverterT::chain_size) {
+            return cvt_.instrumentation().template consumer<I>(slice_push_converter<ConverterT, I + 1>(cvt_));
         } else {
-            std::get<I>(cvt_.chain()).push(
-                std::move(data),
-                last_consumer{ cvt_.consumer() }
-            );
+            return cvt_.instrumentation().template consumer<I>(last_consumer{ cvt_.consumer() });
+        }
+    }
+
+    // passes the collected output of stage I on
+    void forward_chunk() const
+    {
+        if constexpr (chunked) {
+            auto& chunk = cvt_.template stage_chunk<I>();
+            if (!chunk.empty()) {
+                slice_push_converter<ConverterT, I + 1> next_stage{ cvt_ };
+                next_stage(chunk.span());
+                chunk.clear();
+            }
         }
     }
 
+    template <typename DataT>
+    void operator()(DataT data)
+    {
+        cvt_.instrumentation().count_input(I, data);
+        [[maybe_unused]] auto scope = cvt_.instrumentation().stage_scope(I);
+        std::get<I>(cvt_.chain()).push(std::move(data), next());
+    }
+
     void flush()
     {
+        if constexpr (requires { std::get<I>(cvt_.chain()).flush(next()); }) {
+            [[maybe_unused]] auto scope = cvt_.instrumentation().stage_scope(I);
+            std::get<I>(cvt_.chain()).flush(next());
+        }
         if constexpr (I + 1 < ConverterT::chain_size) {
-            slice_push_converter<ConverterT, I + 1> sc(cvt_);
-            if constexpr (requires { std::get<I>(cvt_.chain()).flush(sc); }) {
-                std::get<I>(cvt_.chain()).flush(sc);
-            }
-            sc.flush();
-        } else {
-            if constexpr (requires { std::get<I>(cvt_.chain()).flush(last_consumer{ cvt_.consumer() }); }) {
-                std::get<I>(cvt_.chain()).flush(last_consumer{ cvt_.consumer() });
-            }
+            forward_chunk();
+            slice_push_converter<ConverterT, I + 1>(cvt_).flush();
         }
     }
 
     void finish()
     {
+        {
+            [[maybe_unused]] auto scope = cvt_.instrumentation().stage_scope(I);
+            std::get<I>(cvt_.chain()).finish(next());
+        }
         if constexpr (I + 1 < ConverterT::chain_size) {
-            std::get<I>(cvt_.chain()).finish(
-                slice_push_converter<ConverterT, I + 1>(cvt_)
-            );
+            forward_chunk();
             slice_push_converter<ConverterT, I + 1>(cvt_).finish();
-        } else {
-            std::get<I>(cvt_.chain()).finish(last_consumer{ cvt_.consumer() });
         }
     }
 
@@ -97,17 +187,76 @@ struct slice_push_converter
         if constexpr (I + 1 < ConverterT::chain_size) {
             slice_push_converter<ConverterT, I + 1>(cvt_).reset();
         }
+        if constexpr (chunked) {
+            cvt_.template stage_chunk<I>().clear();
+        }
         if constexpr (requires { std::get<I>(cvt_.chain()).reset(); }) {
             std::get<I>(cvt_.chain()).reset();
         }
     }
 };
 
-template <typename CvtTupleT, typename BaseIteratorT>
+// Collects what stage I emits into its chunk and passes the chunk on when it
+// is full. Output that is already a full chunk is passed on without copying.
+template <typename ConverterT, size_t I>
+struct chunking_consumer
+{
+    ConverterT& cvt_;
+
+    template <typename DataT>
+    void operator()(DataT&& data) const
+    {
+        auto& chunk = cvt_.template stage_chunk<I>();
+        using chunk_t = std::remove_cvref_t<decltype(chunk)>;
+        using element_t = typename decltype(chunk.span())::element_type;
+        using data_t = std::remove_cvref_t<DataT>;
+        slice_push_converter<ConverterT, I> slice{ cvt_ };
+        slice_push_converter<ConverterT, I + 1> next_stage{ cvt_ };
+
+        if constexpr (CompatibleSpan<data_t, std::remove_const_t<element_t>>) {
+            if (chunk.empty() && data.size() >= chunk_t::capacity) {
+                next_stage(span_cast<element_t>(data));
+                return;
+            }
+            chunk.append(span_cast<element_t>(data));
+        } else if constexpr (std::is_integral_v<data_t> && sizeof(data_t) == sizeof(element_t)) {
+            chunk.append(static_cast<std::remove_const_t<element_t>>(data));
+        } else {
+            slice.forward_chunk();
+            next_stage(std::forward<DataT>(data));
+            return;
+        }
+        if (chunk.full()) {
+            slice.forward_chunk();
+        }
+    }
+};
+
+// a consumer that opted in (see is_flushing_consumer) is flushed and
+// finished with the chain
+template <typename ConsumerT>
+inline void flush_consumer(ConsumerT& c)
+{
+    if constexpr (is_flushing_consumer_v<ConsumerT> && requires { c.flush(); }) c.flush();
+}
+
+template <typename ConsumerT>
+inline void finish_consumer(ConsumerT& c)
+{
+    if constexpr (is_flushing_consumer_v<ConsumerT> && requires { c.finish(); }) c.finish();
+    else flush_consumer(c);
+}
+
+// InstrumentationT is no_instrumentation or stage_instrumentation, which
+// makes stats() report the traffic and the time of every stage.
+// ExecutionT is depth_first_execution or stage_major_execution<chunk bytes>.
+template <typename CvtTupleT, typename BaseIteratorT, typename InstrumentationT = no_instrumentation, typename ExecutionT = depth_first_execution>
 class push_converter
 {
     mutable cvt_tuple_wrapper<CvtTupleT> cvt_tuple_;
     mutable BaseIteratorT base;
+    DATAFORGE_NO_UNIQUE_ADDRESS mutable instrumentation_state<InstrumentationT, std::tuple_size_v<CvtTupleT>> instrumentation_;
+    DATAFORGE_NO_UNIQUE_ADDRESS mutable stage_chunks<ExecutionT, CvtTupleT> chunks_;
 
     using consumer_iterator_t = typename std::conditional_t<
         is_reference_wrapper_v<BaseIteratorT>,
@@ -126,6 +275,12 @@ public:
         , base{ std::forward<BaseIteratorArgT>(it) }
     {}
 
+    template <typename ... Quarks, typename BaseIteratorArgT, PipelinePolicy ... PolicyTs>
+    requires(sizeof ...(PolicyTs) > 0)
+    push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, BaseIteratorArgT&& it, PolicyTs ...)
+        : push_converter{ chain, std::forward<BaseIteratorArgT>(it) }
+    {}
+
     template <typename InputDataT>
     void push(InputDataT s)
     {
@@ -135,11 +290,13 @@ public:
     void flush()
     {
         slice_push_converter{ *this }.flush();
+        flush_consumer(consumer());
     }
 
     void finish()
     {
         slice_push_converter{*this}.finish();
+        finish_consumer(consumer());
     }
 
     void reset()
@@ -147,6 +304,17 @@ public:
         slice_push_converter{ *this }.reset();
     }
 
+    // per-stage counters accumulated since construction or reset_stats()
+    pipeline_stats<chain_size> stats() const noexcept requires(InstrumentationT::enabled)
+    {
+        return instrumentation_.stats();
+    }
+
+    void reset_stats() noexcept requires(InstrumentationT::enabled)
+    {
+        instrumentation_.reset();
+    }
+
     inline CvtTupleT& chain() const { return *cvt_tuple_; }
     inline consumer_iterator_t& consumer() const
     {
@@ -156,11 +324,21 @@ public:
             return base;
         }
     }
+    inline auto& instrumentation() const noexcept { return instrumentation_; }
+
+    template <size_t I>
+    requires(is_stage_major_execution<ExecutionT>::value)
+    inline auto& stage_chunk() const noexcept { return std::get<I>(chunks_.chunks); }
 };
 
 template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT>
 push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, BaseIteratorArgT&&)->push_converter<CvtTupleT, std::remove_cvref_t<BaseIteratorArgT>>;
 
+template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT, PipelinePolicy ... PolicyTs>
+requires(sizeof ...(PolicyTs) > 0)
+push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, BaseIteratorArgT&&, PolicyTs ...)->push_converter<CvtTupleT, std::remove_cvref_t<BaseIteratorArgT>,
+    typename pipeline_policies<PolicyTs ...>::instrumentation, typename pipeline_policies<PolicyTs ...>::execution>;
+
 template <typename ET>
 struct polymorphic_push_converter
 {
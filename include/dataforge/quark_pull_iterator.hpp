@@ -34,6 +34,12 @@ public:
         
     }
 
+    // e.g. quark_pull_iterator{ chain, input, stage_instrumentation{} }
+    template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT, InstrumentationPolicy InstrumentationT>
+    quark_pull_iterator(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&& chain, BaseIteratorArgT&& it, InstrumentationT policy)
+        : cvt_{ std::move(chain), std::forward<BaseIteratorArgT>(it), policy }
+    {}
+
     quark_pull_iterator(quark_pull_iterator&&) = default;
     quark_pull_iterator& operator=(quark_pull_iterator&&) = default;
 
@@ -58,6 +64,9 @@ public:
         value_ = {};
     }
 
+    ConverterT& converter() noexcept { return cvt_; }
+    ConverterT const& converter() const noexcept { return cvt_; }
+
 private:
     ConverterT cvt_;
     value_type value_;
@@ -70,4 +79,8 @@ template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT>
 quark_pull_iterator(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, BaseIteratorArgT&&)
     ->quark_pull_iterator<pull_converter<CvtTupleT, std::remove_cvref_t<BaseIteratorArgT>>>;
 
+template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT, InstrumentationPolicy InstrumentationT>
+quark_pull_iterator(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, BaseIteratorArgT&&, InstrumentationT)
+    ->quark_pull_iterator<pull_converter<CvtTupleT, std::remove_cvref_t<BaseIteratorArgT>, InstrumentationT>>;
+
 }
@@ -34,6 +34,13 @@ public:
         : cvt_{ std::move(chain), std::forward<BaseIteratorArgT>(it) }
     {}
 
+    // e.g. quark_push_iterator{ chain, out, stage_instrumentation{}, stage_major_execution{} }
+    template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT, PipelinePolicy ... PolicyTs>
+    requires(sizeof ...(PolicyTs) > 0)
+    quark_push_iterator(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&& chain, BaseIteratorArgT&& it, PolicyTs ... policies)
+        : cvt_{ std::move(chain), std::forward<BaseIteratorArgT>(it), policies ... }
+    {}
+
     quark_push_iterator(quark_push_iterator&&) = default;
     quark_push_iterator& operator=(quark_push_iterator&&) = default;
 
@@ -69,6 +76,9 @@ public:
         cvt_.finish();
     }
 
+    ConverterT& converter() noexcept { return cvt_; }
+    ConverterT const& converter() const noexcept { return cvt_; }
+
 private:
     ConverterT cvt_;
 };
@@ -80,4 +90,10 @@ template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT>
 quark_push_iterator(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, BaseIteratorArgT&&)
     ->quark_push_iterator<push_converter<CvtTupleT, std::remove_cvref_t<BaseIteratorArgT>>>;
 
+template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT, PipelinePolicy ... PolicyTs>
+requires(sizeof ...(PolicyTs) > 0)
+quark_push_iterator(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, BaseIteratorArgT&&, PolicyTs ...)
+    ->quark_push_iterator<push_converter<CvtTupleT, std::remove_cvref_t<BaseIteratorArgT>,
+        typename pipeline_policies<PolicyTs ...>::instrumentation, typename pipeline_policies<PolicyTs ...>::execution>>;
+
 }
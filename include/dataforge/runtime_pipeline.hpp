@@ -0,0 +1,402 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "push_converter.hpp"
+#include "pull_converter.hpp"
+
+namespace dataforge {
+
+// A stage of a pipeline spec: "deflate:6" is { "deflate", { "6" } }.
+struct stage_spec
+{
+    std::string name;
+    std::vector<std::string> args;
+
+    std::string_view arg(size_t i, std::string_view default_value = {}) const
+    {
+        return i < args.size() ? std::string_view{ args[i] } : default_value;
+    }
+
+    int int_arg(size_t i, int default_value) const
+    {
+        if (i >= args.size()) return default_value;
+        int value;
+        auto const [end, ec] = std::from_chars(args[i].data(), args[i].data() + args[i].size(), value);
+        if (ec != std::errc{} || end != args[i].data() + args[i].size()) {
+            throw std::runtime_error("pipeline stage " + name + ": '" + args[i] + "' is not a number");
+        }
+        return value;
+    }
+};
+
+// "utf8|deflate:6|aes:256:ctr|base64" -> the stages in order; the names and
+// the arguments are not checked here
+inline std::vector<stage_spec> parse_pipeline_spec(std::string_view spec)
+{
+    auto trim = [](std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+        return s;
+    };
+    std::vector<stage_spec> result;
+    for (;;) {
+        size_t const bar = spec.find('|');
+        std::string_view part = trim(spec.substr(0, bar));
+        if (part.empty()) throw std::runtime_error("empty stage in the pipeline spec");
+        stage_spec& st = result.emplace_back();
+        size_t colon = part.find(':');
+        st.name = trim(part.substr(0, colon));
+        while (colon != std::string_view::npos) {
+            part.remove_prefix(colon + 1);
+            colon = part.find(':');
+            st.args.emplace_back(trim(part.substr(0, colon)));
+        }
+        if (bar == std::string_view::npos) break;
+        spec.remove_prefix(bar + 1);
+    }
+    return result;
+}
+
+// named byte strings a stage may need (cipher keys, ivs); they aren't part
+// of the spec, which is configuration
+using pipeline_params = std::map<std::string, std::string, std::less<>>;
+
+// The runtime form of a stage: it takes bytes and writes bytes to the next
+// stage, or to the consumer of the pipeline.
+class runtime_stage
+{
+public:
+    virtual ~runtime_stage() = default;
+
+    virtual void push(std::span<const uint8_t> data) = 0;
+    virtual void flush() = 0;
+    virtual void finish() = 0;
+    virtual void reset() = 0;
+
+    void connect(runtime_stage* next) noexcept { next_ = next; }
+
+protected:
+    runtime_stage* next_ = nullptr;
+};
+
+namespace runtime_pipeline_detail {
+
+// collects the output of a compile-time chain; single elements are gathered
+// so that they reach the next stage as one span
+struct stage_output
+{
+    runtime_stage** next;
+    std::vector<uint8_t>* elements;
+
+    template <typename DataT>
+    void operator()(DataT const& data) const
+    {
+        if constexpr (requires { data.size(); }) {
+            static_assert(sizeof(*data.data()) == 1, "a pipeline stage must output bytes");
+            drain();
+            (*next)->push(span_cast<const uint8_t>(std::span{ data.data(), data.size() }));
+        } else {
+            static_assert(sizeof(DataT) == 1, "a pipeline stage must output bytes");
+            elements->push_back(static_cast<uint8_t>(data));
+        }
+    }
+
+    void drain() const
+    {
+        if (!elements->empty()) {
+            (*next)->push(*elements);
+            elements->clear();
+        }
+    }
+};
+
+// the end of a pipeline: hands the output to the consumer in the way
+// push_converter does
+template <typename ConsumerT>
+class consumer_stage final : public runtime_stage
+{
+public:
+    explicit consumer_stage(ConsumerT c) : consumer_{ std::move(c) } {}
+
+    void push(std::span<const uint8_t> data) override { last_consumer{ consumer() }(data); }
+    void flush() override { flush_consumer(consumer()); }
+    void finish() override { finish_consumer(consumer()); }
+    void reset() override {}
+
+private:
+    auto& consumer() noexcept
+    {
+        if constexpr (is_reference_wrapper_v<ConsumerT>) {
+            return consumer_.get();
+        } else {
+            return consumer_;
+        }
+    }
+
+    ConsumerT consumer_;
+};
+
+}
+
+// A compile-time chain as one runtime stage; the fused combinations of a
+// registry are chain_stages of several quarks.
+template <typename CvtTupleT>
+class chain_stage final : public runtime_stage
+{
+    using output_t = runtime_pipeline_detail::stage_output;
+    using input_element_type = typename std::tuple_element_t<0, CvtTupleT>::input_element_type;
+
+public:
+    template <typename ... Quarks>
+    explicit chain_stage(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain)
+        : cvt_{ chain, output_t{ &next_, &elements_ } }
+    {}
+
+    void push(std::span<const uint8_t> data) override
+    {
+        cvt_.push(span_cast<const input_element_type>(data));
+        cvt_.consumer().drain();
+    }
+
+    void flush() override
+    {
+        cvt_.flush();
+        cvt_.consumer().drain();
+        next_->flush();
+    }
+
+    void finish() override
+    {
+        cvt_.finish();
+        cvt_.consumer().drain();
+        next_->finish();
+    }
+
+    void reset() override
+    {
+        cvt_.reset();
+        elements_.clear();
+    }
+
+private:
+    std::vector<uint8_t> elements_;
+    push_converter<CvtTupleT, output_t> cvt_;
+};
+
+// passes the bytes through, e.g. for "utf8" that names the input encoding
+class identity_stage final : public runtime_stage
+{
+public:
+    void push(std::span<const uint8_t> data) override { next_->push(data); }
+    void flush() override { next_->flush(); }
+    void finish() override { next_->finish(); }
+    void reset() override {}
+};
+
+// The stages linked in the order of a spec, the last one writing to the
+// consumer. The stages are on the heap so that the pipeline can be moved.
+class runtime_pipeline
+{
+public:
+    runtime_pipeline(std::vector<std::unique_ptr<runtime_stage>> stages, std::unique_ptr<runtime_stage> output)
+        : stages_{ std::move(stages) }
+        , output_{ std::move(output) }
+    {
+        for (size_t i = 0; i + 1 < stages_.size(); ++i) stages_[i]->connect(stages_[i + 1].get());
+        stages_.back()->connect(output_.get());
+    }
+
+    void push(std::span<const uint8_t> data) { stages_.front()->push(data); }
+    void push(uint8_t elem) { stages_.front()->push(std::span{ &elem, 1 }); }
+    void flush() { stages_.front()->flush(); }
+    void finish() { stages_.front()->finish(); }
+
+    void reset()
+    {
+        for (auto& st : stages_) st->reset();
+    }
+
+    size_t stage_count() const noexcept { return stages_.size(); }
+
+private:
+    std::vector<std::unique_ptr<runtime_stage>> stages_;
+    std::unique_ptr<runtime_stage> output_;
+};
+
+namespace runtime_pipeline_detail {
+
+// the output of a pull pipeline: the bytes of the current pull()
+class buffer_stage final : public runtime_stage
+{
+public:
+    void push(std::span<const uint8_t> data) override { buffer.insert(buffer.end(), data.begin(), data.end()); }
+    void flush() override {}
+    void finish() override {}
+    void reset() override { buffer.clear(); }
+
+    std::vector<uint8_t> buffer;
+};
+
+}
+
+// Runs a runtime pipeline over a source for dynamic_pull_converter: a
+// contiguous range of bytes or, by std::ref, a source with next().
+template <typename SourceT>
+class runtime_pull_pipeline
+{
+public:
+    static constexpr size_t input_piece = 65536;
+
+    runtime_pull_pipeline(std::vector<std::unique_ptr<runtime_stage>> stages, SourceT src)
+        : output_{ new runtime_pipeline_detail::buffer_stage }
+        , pipeline_{ std::move(stages), std::unique_ptr<runtime_stage>{ output_ } }
+        , src_{ std::move(src) }
+    {}
+
+    // the next piece of the output, empty at the end
+    std::span<const uint8_t> pull()
+    {
+        auto& out = output_->buffer;
+        out.clear();
+        while (out.empty() && !finished_) {
+            auto const in = next_input();
+            if (in.empty()) {
+                pipeline_.finish();
+                finished_ = true;
+            } else {
+                pipeline_.push(in);
+            }
+        }
+        return out;
+    }
+
+private:
+    std::span<const uint8_t> next_input()
+    {
+        if constexpr (is_reference_wrapper_v<SourceT>) {
+            return span_cast<const uint8_t>(src_.get().next());
+        } else {
+            auto const all = span_cast<const uint8_t>(std::span{ src_ });
+            auto const in = all.subspan(consumed_, (std::min)(input_piece, all.size() - consumed_));
+            consumed_ += in.size();
+            return in;
+        }
+    }
+
+    runtime_pipeline_detail::buffer_stage* output_;     // owned by the pipeline
+    runtime_pipeline pipeline_;
+    SourceT src_;
+    size_t consumed_ = 0;
+    bool finished_ = false;
+};
+
+// The stages a pipeline spec may use, by name. A factory gets the specs of
+// the stages it replaces and the parameters of the build, and returns a
+// quark chain from bytes to bytes or a runtime_stage:
+//     pipeline_registry reg;
+//     reg.add("base64", [](auto, auto&) { return int8 | base64; });
+//     reg.add("deflate", [](std::span<const stage_spec> s, auto&) { return int8 | deflated(false, 65536, s[0].int_arg(0, -1)); });
+// A factory added for several names in a row makes one compile-time chain of
+// them, so that common combinations run as fast as the static pipeline:
+//     reg.add({ "deflate", "base64" }, [](std::span<const stage_spec> s, auto&) { return int8 | deflated(...) / int8 | base64; });
+// build() takes the longest registered sequence at every position of the spec.
+class pipeline_registry
+{
+public:
+    using factory_type = std::function<std::unique_ptr<runtime_stage>(std::span<const stage_spec>, pipeline_params const&)>;
+
+    template <typename FactoryT>
+    void add(std::vector<std::string> names, FactoryT&& factory)
+    {
+        if (names.empty()) throw std::runtime_error("a pipeline stage needs a name");
+        longest_ = (std::max)(longest_, names.size());
+        factories_[std::move(names)] = [f = std::forward<FactoryT>(factory)](std::span<const stage_spec> specs, pipeline_params const& params) -> std::unique_ptr<runtime_stage> {
+            auto made = f(specs, params);
+            if constexpr (requires { made.get(); }) {
+                return std::unique_ptr<runtime_stage>{ std::move(made) };
+            } else {
+                return std::make_unique<chain_stage<typename decltype(made)::cvt_tuple_type>>(made);
+            }
+        };
+    }
+
+    template <typename FactoryT>
+    void add(std::string name, FactoryT&& factory)
+    {
+        add(std::vector<std::string>{ std::move(name) }, std::forward<FactoryT>(factory));
+    }
+
+    template <typename FactoryT>
+    void add(std::initializer_list<std::string_view> names, FactoryT&& factory)
+    {
+        add(std::vector<std::string>(names.begin(), names.end()), std::forward<FactoryT>(factory));
+    }
+
+    bool contains(std::vector<std::string> const& names) const { return factories_.contains(names); }
+
+    // the stages of a spec, not linked yet
+    std::vector<std::unique_ptr<runtime_stage>> build(std::string_view spec, pipeline_params const& params = {}) const
+    {
+        auto const specs = parse_pipeline_spec(spec);
+        std::vector<std::unique_ptr<runtime_stage>> stages;
+        std::vector<std::string> names;
+        for (size_t pos = 0; pos < specs.size();) {
+            size_t n = (std::min)(longest_, specs.size() - pos);
+            for (; n; --n) {
+                names.clear();
+                for (size_t i = 0; i < n; ++i) names.push_back(specs[pos + i].name);
+                if (auto it = factories_.find(names); it != factories_.end()) {
+                    stages.push_back(it->second(std::span{ specs }.subspan(pos, n), params));
+                    break;
+                }
+            }
+            if (!n) throw std::runtime_error("unknown pipeline stage: " + specs[pos].name);
+            pos += n;
+        }
+        return stages;
+    }
+
+    // a push converter of bytes writing to the consumer (an output iterator,
+    // a back_inserter, a callable, std::ref of a sink)
+    template <typename ConsumerT>
+    dynamic_push_converter<uint8_t> push_pipeline(std::string_view spec, ConsumerT&& consumer, pipeline_params const& params = {}) const
+    {
+        using output_t = runtime_pipeline_detail::consumer_stage<std::remove_cvref_t<ConsumerT>>;
+        return dynamic_push_converter<uint8_t>{ runtime_pipeline{ build(spec, params), std::make_unique<output_t>(std::forward<ConsumerT>(consumer)) } };
+    }
+
+    // a pull converter of bytes reading a contiguous range or, by std::ref,
+    // a source with next()
+    template <typename SourceT>
+    dynamic_pull_converter<const uint8_t> pull_pipeline(std::string_view spec, SourceT src, pipeline_params const& params = {}) const
+    {
+        return dynamic_pull_converter<const uint8_t>{ runtime_pull_pipeline<SourceT>{ build(spec, params), std::move(src) } };
+    }
+
+private:
+    std::map<std::vector<std::string>, factory_type> factories_;
+    size_t longest_ = 0;
+};
+
+}
@@ -0,0 +1,129 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "runtime_pipeline.hpp"
+#include "base_xx/base16.hpp"
+#include "base_xx/base64.hpp"
+#include "compression/deflate.hpp"
+#include "ciphers/aes.hpp"
+
+namespace dataforge {
+
+namespace runtime_stages_detail {
+
+inline int deflate_level(stage_spec const& s)
+{
+    int const level = s.int_arg(0, -1);
+    if (level < -1 || level > 9) throw std::runtime_error("pipeline stage " + s.name + ": the level must be -1..9");
+    return level;
+}
+
+inline cipher_mode_type cipher_mode(stage_spec const& s, size_t i)
+{
+    std::string_view const m = s.arg(i, "cbc");
+    if (m == "ecb") return cipher_mode_type::ECB;
+    if (m == "cbc") return cipher_mode_type::CBC;
+    if (m == "cfb") return cipher_mode_type::CFB;
+    if (m == "ofb") return cipher_mode_type::OFB;
+    if (m == "ctr") return cipher_mode_type::CTR;
+    if (m == "pcbc") return cipher_mode_type::PCBC;
+    throw std::runtime_error("pipeline stage " + s.name + ": unknown cipher mode " + std::string{ m });
+}
+
+// the stream modes need no padding
+inline padding_type cipher_padding(stage_spec const& s, size_t i, cipher_mode_type mode)
+{
+    bool const stream = mode == cipher_mode_type::CFB || mode == cipher_mode_type::OFB || mode == cipher_mode_type::CTR;
+    std::string_view const p = s.arg(i, stream ? "none" : "pkcs");
+    if (p == "none") return padding_type::none;
+    if (p == "zero") return padding_type::zero;
+    if (p == "pkcs") return padding_type::pkcs;
+    throw std::runtime_error("pipeline stage " + s.name + ": unknown padding " + std::string{ p });
+}
+
+inline std::string_view param(pipeline_params const& params, std::string const& stage, std::string_view name, bool required)
+{
+    if (auto it = params.find(name); it != params.end()) return it->second;
+    if (required) throw std::runtime_error("pipeline stage " + stage + " needs the parameter " + std::string{ name });
+    return {};
+}
+
+// "aes:<key bits>:<mode>[:<padding>]" with the key and the iv in the
+// parameters "key" and "iv"
+inline auto aes_quark(stage_spec const& s, pipeline_params const& params)
+{
+    std::string_view const key = param(params, s.name, "key", true);
+    int const key_bits = s.int_arg(0, static_cast<int>(key.size() * 8));
+    if (key_bits != 128 && key_bits != 192 && key_bits != 256) throw std::runtime_error("pipeline stage " + s.name + ": the key must be 128, 192 or 256 bits");
+    if (key.size() * 8 != static_cast<size_t>(key_bits)) throw std::runtime_error("pipeline stage " + s.name + ": the key doesn't have " + std::to_string(key_bits) + " bits");
+    cipher_mode_type const mode = cipher_mode(s, 1);
+    std::string_view const iv = param(params, s.name, "iv", mode != cipher_mode_type::ECB);
+    return aes(128, key, mode, iv, cipher_padding(s, 2, mode));
+}
+
+}
+
+// Registers the standard stages:
+//     utf8                            the input is UTF-8 text, passed as is
+//     base16, base64                  encoding (base16 in lower case)
+//     base16-decode, base64-decode
+//     deflate[:level], inflate        raw deflate; gzip[:level], gunzip
+//     aes:bits:mode[:padding]         encryption with the "key" and "iv"
+//     aes-decrypt:bits:mode[:padding] parameters; modes ecb, cbc, cfb, ofb,
+//                                     ctr, pcbc; padding none, zero, pkcs
+// and the fused combinations deflate|base64, base64-decode|inflate,
+// aes|base64, base64-decode|aes-decrypt, deflate|aes|base64 and
+// base64-decode|aes-decrypt|inflate.
+inline void register_standard_stages(pipeline_registry& reg)
+{
+    using namespace runtime_stages_detail;
+    using specs_t = std::span<const stage_spec>;
+    using params_t = pipeline_params const&;
+
+    reg.add("utf8", [](specs_t, params_t) { return std::make_unique<identity_stage>(); });
+
+    reg.add("base16", [](specs_t, params_t) { return int8 | base16l; });
+    reg.add("base16-decode", [](specs_t, params_t) { return base16l | int8; });
+    reg.add("base64", [](specs_t, params_t) { return int8 | base64; });
+    reg.add("base64-decode", [](specs_t, params_t) { return base64 | int8; });
+
+    reg.add("deflate", [](specs_t s, params_t) { return int8 | deflated(false, 65536, deflate_level(s[0])); });
+    reg.add("inflate", [](specs_t, params_t) { return int8 | inflated(false); });
+    reg.add("gzip", [](specs_t s, params_t) { return int8 | deflated(true, 65536, deflate_level(s[0])); });
+    reg.add("gunzip", [](specs_t, params_t) { return int8 | inflated(true); });
+
+    reg.add("aes", [](specs_t s, params_t p) { return int8 | aes_quark(s[0], p) / int8; });
+    reg.add("aes-decrypt", [](specs_t s, params_t p) { return int8 / aes_quark(s[0], p) | int8; });
+
+    reg.add({ "deflate", "base64" }, [](specs_t s, params_t) {
+        return int8 | deflated(false, 65536, deflate_level(s[0])) / int8 | base64;
+    });
+    reg.add({ "base64-decode", "inflate" }, [](specs_t, params_t) {
+        return base64 | int8 | inflated(false);
+    });
+    reg.add({ "aes", "base64" }, [](specs_t s, params_t p) {
+        return int8 | aes_quark(s[0], p) / int8 | base64;
+    });
+    reg.add({ "base64-decode", "aes-decrypt" }, [](specs_t s, params_t p) {
+        return base64 | int8 / aes_quark(s[1], p) | int8;
+    });
+    reg.add({ "deflate", "aes", "base64" }, [](specs_t s, params_t p) {
+        return int8 | deflated(false, 65536, deflate_level(s[0])) / int8 | aes_quark(s[1], p) / int8 | base64;
+    });
+    reg.add({ "base64-decode", "aes-decrypt", "inflate" }, [](specs_t s, params_t p) {
+        return base64 | int8 / aes_quark(s[1], p) | int8 | inflated(false);
+    });
+}
+
+}
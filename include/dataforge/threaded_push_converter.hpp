@@ -0,0 +1,411 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "push_converter.hpp"
+#include "detail/utility/spsc_ring.hpp"
+
+namespace dataforge {
+
+// The stage indices a threaded_push_converter starts a new thread at, e.g.
+// thread_boundaries<1, 2> for lzma | aes | sha256 runs each stage on its own
+// thread. Stages before the first boundary run on the pushing thread.
+template <size_t ... BoundariesV>
+struct thread_boundaries {};
+
+struct stage_link_options
+{
+    size_t chunk_bytes;
+    size_t slots;
+};
+
+// The connection of two threads: chunks of the output of the last stage of
+// one segment travel to the next one through a ring of messages, and the
+// consumed chunk buffers return through a second ring for reuse.
+template <typename ET>
+class stage_link
+{
+public:
+    enum class signal { data, flush, finish, reset, stop };
+
+    struct message
+    {
+        signal kind = signal::data;
+        std::vector<ET> data;
+    };
+
+    explicit stage_link(stage_link_options const& opts)
+        : chunk_elements_{ (std::max)(opts.chunk_bytes / sizeof(ET), size_t{ 1 }) }
+        , messages_{ opts.slots }
+        , buffers_{ opts.slots + 2 } // every buffer in flight fits
+    {
+        current_.reserve(chunk_elements_);
+    }
+
+    // producer side: the consumer of the stage before the boundary
+    template <typename DataT>
+    void operator()(DataT&& data)
+    {
+        if constexpr (CompatibleSpan<std::remove_cvref_t<DataT>, ET>) {
+            auto sp = span_cast<const ET>(std::span{ data });
+            while (!sp.empty()) {
+                size_t const n = (std::min)(sp.size(), chunk_elements_ - current_.size());
+                current_.insert(current_.end(), sp.begin(), sp.begin() + n);
+                sp = sp.subspan(n);
+                if (current_.size() == chunk_elements_) publish();
+            }
+        } else {
+            current_.push_back(static_cast<ET>(data));
+            if (current_.size() == chunk_elements_) publish();
+        }
+    }
+
+    // passes the pending chunk on, then the signal
+    void send(signal s)
+    {
+        if (s == signal::reset) {
+            current_.clear();
+        } else {
+            publish();
+        }
+        messages_.push(message{ s, {} });
+    }
+
+    // consumer side
+    message receive() { return messages_.pop(); }
+
+    void recycle(std::vector<ET>&& buffer)
+    {
+        buffer.clear();
+        buffers_.try_push(std::move(buffer));
+    }
+
+private:
+    void publish()
+    {
+        if (current_.empty()) return;
+        messages_.push(message{ signal::data, std::move(current_) });
+        current_ = {};
+        if (!buffers_.try_pop(current_)) {
+            current_.reserve(chunk_elements_);
+        }
+    }
+
+    size_t chunk_elements_;
+    std::vector<ET> current_;
+    spsc_ring<message> messages_;
+    spsc_ring<std::vector<ET>> buffers_;
+};
+
+// A run of consecutive stages of a chain with its own consumer, driven by
+// slice_push_converter like a whole push_converter.
+template <typename StageRefTupleT, typename ConsumerT>
+class pipeline_segment
+{
+    mutable StageRefTupleT stages_;
+    ConsumerT& consumer_;
+
+public:
+    static constexpr size_t chain_size = std::tuple_size_v<StageRefTupleT>;
+
+    pipeline_segment(StageRefTupleT stages, ConsumerT& consumer) noexcept
+        : stages_{ stages }, consumer_{ consumer }
+    {}
+
+    inline StageRefTupleT& chain() const noexcept { return stages_; }
+    inline ConsumerT& consumer() const noexcept { return consumer_; }
+    static constexpr instrumentation_state<no_instrumentation, chain_size> instrumentation() noexcept { return {}; }
+};
+
+// A push converter whose chain is split at the given stage boundaries into
+// segments running on their own threads. The throughput approaches the one
+// of the slowest segment instead of the sum of all stages. The pushing
+// thread blocks when the ring to the next thread is full.
+//
+// flush() and finish() return when the whole chain is flushed or finished
+// and the output is written; the first exception thrown on a worker thread
+// is rethrown from them. reset() may follow finish() to convert again.
+template <typename CvtTupleT, typename BaseIteratorT, typename BoundariesT> class threaded_push_converter;
+
+template <typename CvtTupleT, typename BaseIteratorT, size_t ... BoundariesV>
+class threaded_push_converter<CvtTupleT, BaseIteratorT, thread_boundaries<BoundariesV ...>>
+{
+public:
+    static constexpr size_t chain_size = std::tuple_size_v<CvtTupleT>;
+    static constexpr size_t segment_count = sizeof ...(BoundariesV) + 1;
+    using input_element_type = typename std::tuple_element_t<0, CvtTupleT>::input_element_type;
+    using output_element_type = typename std::tuple_element_t<chain_size - 1, CvtTupleT>::output_element_type;
+
+private:
+    static constexpr std::array<size_t, segment_count + 1> bounds{ 0, BoundariesV ..., chain_size };
+
+    static_assert(sizeof ...(BoundariesV) > 0, "no thread boundaries given");
+    static_assert([] {
+        for (size_t s = 0; s < segment_count; ++s) {
+            if (bounds[s] >= bounds[s + 1]) return false;
+        }
+        return true;
+    }(), "thread boundaries must be increasing stage indices within the chain");
+
+    // the elements passed from segment S to segment S + 1
+    template <size_t S>
+    using link_element_t = typename std::tuple_element_t<bounds[S + 1] - 1, CvtTupleT>::output_element_type;
+
+    template <typename> struct links_of;
+    template <size_t ... S>
+    struct links_of<std::index_sequence<S ...>>
+    {
+        using type = std::tuple<stage_link<link_element_t<S>> ...>;
+    };
+    using links_t = typename links_of<std::make_index_sequence<segment_count - 1>>::type;
+
+    using consumer_iterator_t = typename std::conditional_t<
+        is_reference_wrapper_v<BaseIteratorT>,
+        BaseIteratorT,
+        std::type_identity<BaseIteratorT>
+    >::type;
+
+    struct state
+    {
+        cvt_tuple_wrapper<CvtTupleT> cvt_tuple;
+        BaseIteratorT base;
+        links_t links;
+        std::vector<std::thread> workers;
+        std::atomic<uint64_t> completed{ 0 };
+        uint64_t requested = 0;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        template <typename ChainT, typename BaseIteratorArgT, size_t ... S>
+        state(ChainT const& chain, BaseIteratorArgT&& it, size_t chunk_bytes, size_t ring_slots, std::index_sequence<S ...>)
+            : cvt_tuple{ chain }
+            , base{ std::forward<BaseIteratorArgT>(it) }
+            , links{ ((void)S, stage_link_options{ chunk_bytes, ring_slots }) ... }
+        {}
+
+        consumer_iterator_t& consumer()
+        {
+            if constexpr (is_reference_wrapper_v<BaseIteratorT>) {
+                return base.get();
+            } else {
+                return base;
+            }
+        }
+
+        void set_error(std::exception_ptr e)
+        {
+            std::lock_guard lock{ error_mutex };
+            if (!error) error = std::move(e);
+        }
+    };
+
+    template <size_t S, size_t ... J>
+    static auto stage_refs(CvtTupleT& t, std::index_sequence<J ...>) noexcept
+    {
+        return std::tie(std::get<bounds[S] + J>(t) ...);
+    }
+
+    template <size_t S>
+    static auto segment(state& st) noexcept
+    {
+        auto stages = stage_refs<S>(*st.cvt_tuple, std::make_index_sequence<bounds[S + 1] - bounds[S]>());
+        if constexpr (S + 1 < segment_count) {
+            return pipeline_segment{ stages, std::get<S>(st.links) };
+        } else {
+            return pipeline_segment{ stages, st.consumer() };
+        }
+    }
+
+    // passes a signal from segment S to the next one; the last segment
+    // reports the completion of flush, finish and reset to the pushing thread
+    template <size_t S, typename SignalT>
+    static void forward(state& st, SignalT s)
+    {
+        if constexpr (S + 1 < segment_count) {
+            std::get<S>(st.links).send(s);
+        } else if (s != SignalT::stop) {
+            st.completed.fetch_add(1, std::memory_order_release);
+            st.completed.notify_all();
+        }
+    }
+
+    template <size_t S>
+    static void run_segment(state& st)
+    {
+        using signal = typename stage_link<link_element_t<S - 1>>::signal;
+        auto& in = std::get<S - 1>(st.links);
+        auto seg = segment<S>(st);
+        slice_push_converter<decltype(seg)> head{ seg };
+
+        // after a failure the segment drops its input until reset
+        bool failed = false;
+        auto guarded = [&](auto const& fn) {
+            if (failed) return;
+            try {
+                fn();
+            } catch (...) {
+                failed = true;
+                st.set_error(std::current_exception());
+            }
+        };
+
+        for (;;) {
+            auto msg = in.receive();
+            switch (msg.kind) {
+            case signal::data:
+                guarded([&] { head(std::span<const link_element_t<S - 1>>{ msg.data }); });
+                in.recycle(std::move(msg.data));
+                continue;
+            case signal::flush:
+                guarded([&] { head.flush(); });
+                if constexpr (S + 1 == segment_count) guarded([&] { flush_consumer(st.consumer()); });
+                forward<S>(st, signal::flush);
+                continue;
+            case signal::finish:
+                guarded([&] { head.finish(); });
+                if constexpr (S + 1 == segment_count) guarded([&] { finish_consumer(st.consumer()); });
+                forward<S>(st, signal::finish);
+                continue;
+            case signal::reset:
+                failed = false;
+                guarded([&] { head.reset(); });
+                forward<S>(st, signal::reset);
+                continue;
+            case signal::stop:
+                forward<S>(st, signal::stop);
+                return;
+            }
+        }
+    }
+
+    template <size_t ... S>
+    void start_workers(std::index_sequence<S ...>)
+    {
+        (state_->workers.emplace_back([st = state_.get()] { run_segment<S + 1>(*st); }), ...);
+    }
+
+    // sends a signal after the segment of the pushing thread and waits until
+    // it passes the last segment
+    template <typename SignalT>
+    void synchronize(SignalT s)
+    {
+        state& st = *state_;
+        std::get<0>(st.links).send(s);
+        ++st.requested;
+        for (uint64_t done; (done = st.completed.load(std::memory_order_acquire)) != st.requested;) {
+            st.completed.wait(done, std::memory_order_acquire);
+        }
+    }
+
+    void rethrow_error()
+    {
+        std::lock_guard lock{ state_->error_mutex };
+        if (state_->error) std::rethrow_exception(state_->error);
+    }
+
+    auto head_segment() const noexcept { return segment<0>(*state_); }
+
+    using signal_t = typename stage_link<link_element_t<0>>::signal;
+
+    std::unique_ptr<state> state_;
+
+public:
+    // chunk_bytes is the size of the chunks passed between the threads,
+    // ring_slots the number of chunks a ring holds
+    template <typename ... Quarks, typename BaseIteratorArgT>
+    threaded_push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>> const& chain, BaseIteratorArgT&& it,
+        thread_boundaries<BoundariesV ...>, size_t chunk_bytes = 64 * 1024, size_t ring_slots = 4)
+        : state_{ std::make_unique<state>(chain, std::forward<BaseIteratorArgT>(it), chunk_bytes, (std::max)(ring_slots, size_t{ 1 }),
+            std::make_index_sequence<segment_count - 1>()) }
+    {
+        state_->workers.reserve(segment_count - 1);
+        try {
+            start_workers(std::make_index_sequence<segment_count - 1>());
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    threaded_push_converter(threaded_push_converter&&) noexcept = default;
+    threaded_push_converter& operator=(threaded_push_converter&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            stop();
+            state_ = std::move(rhs.state_);
+        }
+        return *this;
+    }
+
+    ~threaded_push_converter() { stop(); }
+
+    template <typename InputDataT>
+    void push(InputDataT s)
+    {
+        auto seg = head_segment();
+        slice_push_converter<decltype(seg)>{ seg }(std::move(s));
+    }
+
+    void flush()
+    {
+        auto seg = head_segment();
+        slice_push_converter<decltype(seg)>{ seg }.flush();
+        synchronize(signal_t::flush);
+        rethrow_error();
+    }
+
+    void finish()
+    {
+        auto seg = head_segment();
+        slice_push_converter<decltype(seg)>{ seg }.finish();
+        synchronize(signal_t::finish);
+        rethrow_error();
+    }
+
+    void reset()
+    {
+        auto seg = head_segment();
+        slice_push_converter<decltype(seg)>{ seg }.reset();
+        synchronize(signal_t::reset);
+        std::lock_guard lock{ state_->error_mutex };
+        state_->error = nullptr;
+    }
+
+    inline CvtTupleT& chain() const { return *state_->cvt_tuple; }
+    inline consumer_iterator_t& consumer() const { return state_->consumer(); }
+
+private:
+    void stop() noexcept
+    {
+        if (!state_) return;
+        if (!state_->workers.empty()) {
+            std::get<0>(state_->links).send(signal_t::stop);
+            for (std::thread& th : state_->workers) th.join();
+        }
+        state_.reset();
+    }
+};
+
+template <typename CvtTupleT, typename ... Quarks, typename BaseIteratorArgT, size_t ... BoundariesV, std::convertible_to<size_t> ... SizeTs>
+threaded_push_converter(quark_chain<CvtTupleT, std::tuple<Quarks ...>>&&, BaseIteratorArgT&&, thread_boundaries<BoundariesV ...>, SizeTs ...)
+    ->threaded_push_converter<CvtTupleT, std::remove_cvref_t<BaseIteratorArgT>, thread_boundaries<BoundariesV ...>>;
+
+}
@@ -0,0 +1,407 @@
+/*=============================================================================
+    Copyright (c) 2026 Alexander Pototskiy
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "detail/utility/consumer_traits.hpp"
+#include "detail/utility/io_uring_queue.hpp"
+
+namespace dataforge {
+
+struct uring_file_options
+{
+    size_t block_bytes = size_t{ 1 } << 20;     // the size of a request, at most 4 GiB - 1
+    unsigned queue_depth = 4;                   // the requests kept in flight
+    bool use_io_uring = true;                   // false: blocking pread/pwrite
+};
+
+namespace uring_file_detail {
+
+inline int open_file(std::string const& path, bool write) noexcept
+{
+#if defined(_WIN32)
+    int const flags = _O_BINARY | _O_NOINHERIT | (write ? _O_WRONLY | _O_CREAT | _O_TRUNC : _O_RDONLY);
+    return ::_open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+    int const flags = O_CLOEXEC | (write ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY);
+    return ::open(path.c_str(), flags, 0644);
+#endif
+}
+
+inline void close_file(int fd) noexcept
+{
+#if defined(_WIN32)
+    ::_close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+// closes the descriptor until io_state takes it over
+struct file_guard
+{
+    int fd;
+
+    explicit file_guard(int f) noexcept : fd{ f } {}
+    file_guard(file_guard const&) = delete;
+    file_guard& operator=(file_guard const&) = delete;
+    ~file_guard() { if (fd >= 0) close_file(fd); }
+
+    int release() noexcept { return std::exchange(fd, -1); }
+};
+
+// -1 if the size can't be read
+inline int64_t file_size(int fd) noexcept
+{
+#if defined(_WIN32)
+    struct _stat64 st;
+    return ::_fstat64(fd, &st) == 0 ? static_cast<int64_t>(st.st_size) : -1;
+#else
+    struct stat st;
+    return ::fstat(fd, &st) == 0 ? static_cast<int64_t>(st.st_size) : -1;
+#endif
+}
+
+// the buffers of the requests; a block is in flight while pending is set
+struct io_slot
+{
+    unsigned char* data;
+    size_t size = 0;
+    uint64_t offset = 0;
+    int result = 0;
+    bool pending = false;
+};
+
+struct io_state
+{
+    int fd = -1;
+    size_t block_bytes;
+    std::unique_ptr<unsigned char[]> memory;
+    std::vector<io_slot> slots;
+#if defined(DATAFORGE_HAS_IO_URING)
+    std::unique_ptr<io_uring_queue> ring;       // empty: blocking I/O
+#endif
+
+    // a request's length is 32 bits in the submission entry
+    io_state(int f, uring_file_options const& opts)
+        : fd{ f }
+        , block_bytes{ std::clamp(opts.block_bytes, size_t{ 1 }, size_t{ UINT32_MAX }) }
+    {
+        unsigned depth = 1;
+#if defined(DATAFORGE_HAS_IO_URING)
+        if (opts.use_io_uring) {
+            depth = (std::max)(opts.queue_depth, 1u);
+            ring = std::make_unique<io_uring_queue>();
+            if (!ring->open(depth)) {
+                ring.reset();
+                depth = 1;
+            }
+        }
+#endif
+        memory = std::make_unique_for_overwrite<unsigned char[]>(depth * block_bytes);
+        slots.resize(depth);
+        for (unsigned i = 0; i < depth; ++i) slots[i].data = memory.get() + i * block_bytes;
+#if defined(DATAFORGE_HAS_IO_URING)
+        if (ring) {
+            std::vector<iovec> bufs(depth);
+            for (unsigned i = 0; i < depth; ++i) bufs[i] = { slots[i].data, block_bytes };
+            ring->register_buffers(bufs.data(), depth);
+        }
+#endif
+    }
+
+    io_state(io_state const&) = delete;
+    io_state& operator=(io_state const&) = delete;
+
+    // the kernel may still write to the buffers
+    ~io_state()
+    {
+        try {
+            drain();
+        } catch (...) {}
+        if (fd >= 0) close_file(fd);
+    }
+
+    bool asynchronous() const noexcept
+    {
+#if defined(DATAFORGE_HAS_IO_URING)
+        return !!ring;
+#else
+        return false;
+#endif
+    }
+
+    void read(size_t si)
+    {
+#if defined(DATAFORGE_HAS_IO_URING)
+        io_slot& s = slots[si];
+        s.pending = true;
+        ring->read(fd, s.data, static_cast<unsigned>(s.size), s.offset, static_cast<unsigned>(si), si);
+        ring->submit();
+#endif
+    }
+
+    void write(size_t si)
+    {
+#if defined(DATAFORGE_HAS_IO_URING)
+        io_slot& s = slots[si];
+        s.pending = true;
+        ring->write(fd, s.data, static_cast<unsigned>(s.size), s.offset, static_cast<unsigned>(si), si);
+        ring->submit();
+#endif
+    }
+
+    // waits for the request of the slot
+    void wait(size_t si)
+    {
+#if defined(DATAFORGE_HAS_IO_URING)
+        while (slots[si].pending) {
+            auto const c = ring->wait();
+            io_slot& s = slots[c.user_data];
+            s.result = c.result;
+            s.pending = false;
+        }
+#endif
+    }
+
+    void drain()
+    {
+        for (size_t si = 0; si < slots.size(); ++si) wait(si);
+    }
+};
+
+}
+
+// A file source for pull converters that reads ahead with io_uring:
+//     uring_file_source src{ "data.bin" };
+//     auto it = quark_pull_iterator{ int8 | sha256, std::ref(src) };
+// queue_depth reads of block_bytes are kept in flight while the chain
+// converts the block next() returned last; that span stays valid until the
+// following next(). Where io_uring is not available (not Linux, or refused
+// by the kernel) the blocks are read one at a time by a blocking pread(),
+// or ReadFile() at an OVERLAPPED offset on Windows.
+class uring_file_source
+{
+public:
+    explicit uring_file_source(std::string const& path, uring_file_options const& opts = {})
+    {
+        uring_file_detail::file_guard file{ uring_file_detail::open_file(path, false) };
+        if (file.fd < 0) throw std::runtime_error("uring_file_source: can't open " + path);
+        int64_t const size = uring_file_detail::file_size(file.fd);
+        if (size < 0) throw std::runtime_error("uring_file_source: can't get the size of " + path);
+        size_ = static_cast<uint64_t>(size);
+        state_ = std::make_unique<uring_file_detail::io_state>(file.fd, opts);
+        file.release();
+        start();
+    }
+
+    std::span<const unsigned char> next()
+    {
+        auto& st = *state_;
+        if (!st.asynchronous()) {
+            if (next_offset_ >= size_) return {};
+            auto& s = st.slots[0];
+            size_t const n = pread_full(st.fd, s.data, (std::min)(uint64_t{ st.block_bytes }, size_ - next_offset_), next_offset_);
+            next_offset_ = n ? next_offset_ + n : size_;
+            return { s.data, n };
+        }
+
+        // the span returned last is released: its slot reads ahead again
+        if (current_ != no_slot) {
+            request(current_);
+            current_ = no_slot;
+        }
+        if (next_offset_ >= size_) return {};
+        size_t const si = static_cast<size_t>(next_offset_ / st.block_bytes % st.slots.size());
+        st.wait(si);
+        auto& s = st.slots[si];
+        if (s.result < 0) throw_io_error(-s.result, "uring_file_source: read failed");
+        size_t n = static_cast<size_t>(s.result);
+        if (n < s.size) n += pread_full(st.fd, s.data + n, s.size - n, s.offset + n);
+        next_offset_ += s.size;
+        current_ = si;
+        return { s.data, n };
+    }
+
+    // starts over from the beginning of the file
+    void rewind()
+    {
+        state_->drain();
+        start();
+    }
+
+    uint64_t size() const noexcept { return size_; }
+    bool uses_io_uring() const noexcept { return state_->asynchronous(); }
+
+private:
+    static constexpr size_t no_slot = static_cast<size_t>(-1);
+
+    void start()
+    {
+        read_offset_ = next_offset_ = 0;
+        current_ = no_slot;
+        if (state_->asynchronous()) {
+            for (size_t si = 0; si < state_->slots.size(); ++si) request(si);
+        }
+    }
+
+    void request(size_t si)
+    {
+        if (read_offset_ >= size_) return;
+        auto& s = state_->slots[si];
+        s.offset = read_offset_;
+        s.size = static_cast<size_t>((std::min)(uint64_t{ state_->block_bytes }, size_ - read_offset_));
+        read_offset_ += s.size;
+        state_->read(si);
+    }
+
+    std::unique_ptr<uring_file_detail::io_state> state_;
+    uint64_t size_ = 0;
+    uint64_t read_offset_ = 0;  // of the next block to request
+    uint64_t next_offset_ = 0;  // of the next block to hand out
+    size_t current_ = no_slot;  // the slot handed out last
+};
+
+// A consumer for push pipelines that writes a file (created or truncated)
+// with io_uring. The output is copied into one of queue_depth buffers of
+// block_bytes; a full buffer is submitted and the next one is filled while
+// the kernel writes. flush() and finish(), which push_converter calls for
+// its consumer, submit the partial buffer and wait for all the writes.
+// Without io_uring the buffer is written by a blocking pwrite(), or
+// WriteFile() at an OVERLAPPED offset on Windows.
+class uring_file_sink
+{
+public:
+    using consumer_category = flushing_consumer_tag;
+
+    explicit uring_file_sink(std::string const& path, uring_file_options const& opts = {})
+    {
+        uring_file_detail::file_guard file{ uring_file_detail::open_file(path, true) };
+        if (file.fd < 0) throw std::runtime_error("uring_file_sink: can't open " + path);
+        state_ = std::make_unique<uring_file_detail::io_state>(file.fd, opts);
+        file.release();
+    }
+
+    uring_file_sink(uring_file_sink&&) noexcept = default;
+    uring_file_sink& operator=(uring_file_sink&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            close();
+            state_ = std::move(rhs.state_);
+            current_ = rhs.current_;
+            filled_ = rhs.filled_;
+            offset_ = rhs.offset_;
+            written_ = rhs.written_;
+        }
+        return *this;
+    }
+
+    // the buffered output is written, errors are ignored; call finish() to see them
+    ~uring_file_sink() { close(); }
+
+    template <typename DataT>
+    void operator()(DataT const& data)
+    {
+        if constexpr (requires { data.size_bytes(); }) {
+            write(data.data(), data.size_bytes());
+        } else {
+            static_assert(std::is_trivially_copyable_v<DataT>);
+            write(&data, sizeof(DataT));
+        }
+    }
+
+    void write(const void* data, size_t size)
+    {
+        auto const* p = static_cast<const unsigned char*>(data);
+        size_t const block = state_->block_bytes;
+        while (size) {
+            size_t const n = (std::min)(size, block - filled_);
+            std::memcpy(state_->slots[current_].data + filled_, p, n);
+            filled_ += n;
+            p += n;
+            size -= n;
+            if (filled_ == block) submit();
+        }
+    }
+
+    void flush()
+    {
+        submit();
+        for (size_t si = 0; si < state_->slots.size(); ++si) complete(si);
+    }
+
+    void finish() { flush(); }
+
+    void close()
+    {
+        if (!state_) return;
+        try {
+            finish();
+        } catch (...) {}
+        state_.reset();
+    }
+
+    uint64_t bytes_written() const noexcept { return written_; }
+    bool uses_io_uring() const noexcept { return state_->asynchronous(); }
+
+private:
+    void submit()
+    {
+        if (!filled_) return;
+        auto& st = *state_;
+        auto& s = st.slots[current_];
+        s.size = filled_;
+        s.offset = offset_;
+        offset_ += filled_;
+        filled_ = 0;
+        if (!st.asynchronous()) {
+            pwrite_full(st.fd, s.data, s.size, s.offset);
+            written_ += std::exchange(s.size, 0);
+            return;
+        }
+        st.write(current_);
+        current_ = (current_ + 1) % st.slots.size();
+        complete(current_);
+    }
+
+    // waits for the write of the slot; a short write is finished by pwrite()
+    void complete(size_t si)
+    {
+        auto& st = *state_;
+        auto& s = st.slots[si];
+        if (!s.size) return;
+        st.wait(si);
+        size_t const n = s.size;
+        s.size = 0;
+        if (s.result < 0) throw_io_error(-s.result, "uring_file_sink: write failed");
+        size_t const done = static_cast<size_t>(s.result);
+        if (done < n) pwrite_full(st.fd, s.data + done, n - done, s.offset + done);
+        written_ += n;
+    }
+
+    std::unique_ptr<uring_file_detail::io_state> state_;
+    size_t current_ = 0;    // the slot being filled
+    size_t filled_ = 0;
+    uint64_t offset_ = 0;
+    uint64_t written_ = 0;
+};
+
+}
@@ -7,17 +7,36 @@
 ==============================================================================*/
 #include "test_common.hpp"
 
+#include <filesystem>
+#include <fstream>
+#include <deque>
 #include <list>
+#include <ranges>
+#include <sstream>
 #include <string>
 
 #include "dataforge/basic/group.hpp"
 #include "dataforge/basic/buffer.hpp"
+#include "dataforge/threaded_push_converter.hpp"
+#include "dataforge/parallel_convert.hpp"
+#include "dataforge/async_pull_iterator.hpp"
+#include "dataforge/mapped_file_source.hpp"
+#include "dataforge/fd_sink.hpp"
+#include "dataforge/uring_file.hpp"
+#include "dataforge/convert.hpp"
+#include "dataforge/bounded_push_converter.hpp"
+#include "dataforge/batched_push_converter.hpp"
+#include "dataforge/basic/tee.hpp"
+#include "dataforge/runtime_stages.hpp"
+#include "dataforge/checksum/crc.hpp"
+#include "dataforge/hashes/sha2.hpp"
 #include "dataforge/compression/deflate.hpp"
 #include "dataforge/compression/bzip2.hpp"
 #include "dataforge/compression/lzma.hpp"
 #include "dataforge/compression/lz4.hpp"
 #include "dataforge/base_xx/base16.hpp"
 #include "dataforge/base_xx/base64.hpp"
+#include "dataforge/ciphers/aes.hpp"
 
 #if DATAFORGE_TEST_FULL_SUITE
 
@@ -95,6 +114,13 @@ void bzip2_test()
     DATAFORGE_PULL_TEST(int8 | bzip2(256) | int8, spans6, sp);
 
     DATAFORGE_PULL_TEST(int8 | bzip2(256) | int8, sp, sp);
+
+    // the compressor alone is pulled to the end of the stream
+    std::vector<char> compressed;
+    auto cmp_it = quark_push_iterator{ int8 | bzip2(256), std::back_inserter(compressed) };
+    *cmp_it = sp;
+    cmp_it.finish();
+    DATAFORGE_PULL_TEST(int8 | bzip2(256), sp, std::span{ compressed });
 }
 
 void lzma_test()
@@ -146,6 +172,580 @@ void lz4_test()
     DATAFORGE_PULL_TEST(int8 | lz4() | int8, spans, sp);
 }
 
+void instrumentation_test()
+{
+    std::string input;
+    for (size_t i = 0; i < 10000; ++i) input += "instrumented pipeline "[i % 22];
+
+    std::string plain, result;
+    auto plain_it = quark_push_iterator{ int8 | deflated(false, 256) | int8 | base64, std::back_inserter(plain) };
+    *plain_it = input;
+    plain_it.finish();
+
+    auto cvt_it = quark_push_iterator{ int8 | deflated(false, 256) | int8 | base64, std::back_inserter(result), stage_instrumentation{} };
+    *cvt_it = input;
+    cvt_it.finish();
+    EXPECT_TRUE(result == plain) << "ERROR in instrumentation_test: push output";
+
+    // every stage passes on what the next one receives
+    auto check = [&](auto const& stats, bool push) {
+        auto const& st = stats.stages;
+        EXPECT_EQ(st.size(), 3u);
+        EXPECT_EQ(st[0].input_elements, input.size());
+        EXPECT_EQ(st[0].output_elements, st[1].input_elements);
+        EXPECT_EQ(st[1].output_elements, input.size());
+        EXPECT_EQ(st[1].output_elements, st[2].input_elements);
+        EXPECT_EQ(st[2].output_elements, plain.size());
+        EXPECT_TRUE(st[0].calls && st[1].calls && st[2].calls);
+        EXPECT_TRUE(st[0].cycles && st[1].cycles && st[2].cycles);
+        for (auto const& s : st) {
+            EXPECT_EQ(push ? s.provider_calls : s.consumer_calls, 0u);
+            EXPECT_TRUE(push ? s.consumer_calls : s.provider_calls);
+        }
+    };
+    check(cvt_it.converter().stats(), true);
+    cvt_it.converter().reset_stats();
+    EXPECT_EQ(cvt_it.converter().stats().stages[2].output_elements, 0u);
+
+    auto pull_it = quark_pull_iterator{ int8 | deflated(false, 256) | int8 | base64, input, stage_instrumentation{} };
+    EXPECT_TRUE(collect_pulled(pull_it) == plain) << "ERROR in instrumentation_test: pull output";
+    check(pull_it.converter().stats(), false);
+}
+
+void stage_major_test()
+{
+    std::string input;
+    for (size_t i = 0; i < 20000; ++i) input += "stage-major chunks "[i % 19];
+
+    auto run = [&input](auto... policies) {
+        std::string result;
+        auto it = quark_push_iterator{ int8 | deflated(false, 256) | int8 | base64, std::back_inserter(result), policies... };
+        for (size_t pos = 0; pos < input.size(); pos += 333) {
+            *it = std::string_view{ input }.substr(pos, 333);
+            if (pos == 9990) it.flush();
+        }
+        it.finish();
+        return result;
+    };
+    std::string const plain = run();
+    EXPECT_TRUE(run(stage_major_execution<64>{}) == plain) << "ERROR in stage_major_test: 64-byte chunks";
+    EXPECT_TRUE(run(stage_major_execution{}) == plain) << "ERROR in stage_major_test: default chunks";
+    EXPECT_TRUE(run(stage_instrumentation{}, stage_major_execution<256>{}) == plain) << "ERROR in stage_major_test: instrumented";
+
+    // element-wise pushes
+    std::string df, sm;
+    auto df_it = quark_push_iterator{ int8 | base16l / int8 | base64, std::back_inserter(df) };
+    auto sm_it = quark_push_iterator{ int8 | base16l / int8 | base64, std::back_inserter(sm), stage_major_execution<4>{} };
+    for (char c : input.substr(0, 1000)) { *df_it = c; *sm_it = c; }
+    df_it.finish();
+    sm_it.finish();
+    EXPECT_TRUE(df == sm) << "ERROR in stage_major_test: element-wise";
+}
+
+void threaded_test()
+{
+    std::string input;
+    for (size_t i = 0; i < 20000; ++i) input += "threaded stages "[i % 16];
+
+    auto feed = [&input](auto& it) {
+        for (size_t pos = 0; pos < input.size(); pos += 333) {
+            *it = std::string_view{ input }.substr(pos, 333);
+            if (pos == 9990) it.flush();
+        }
+        it.finish();
+    };
+
+    std::string plain, result;
+    auto plain_it = quark_push_iterator{ int8 | deflated(false, 256) | int8 | base64, std::back_inserter(plain) };
+    feed(plain_it);
+
+    // small chunks and rings to exercise the backpressure
+    auto cvt_it = quark_push_iterator{ threaded_push_converter{
+        int8 | deflated(false, 256) | int8 | base64, std::back_inserter(result), thread_boundaries<1, 2>{}, 64, 2 } };
+    feed(cvt_it);
+    EXPECT_TRUE(result == plain) << "ERROR in threaded_test";
+
+    result.clear();
+    cvt_it.converter().reset();
+    feed(cvt_it);
+    EXPECT_TRUE(result == plain) << "ERROR in threaded_test: after reset";
+
+    // an exception of a worker thread is rethrown from finish()
+    std::string out;
+    auto bad_it = quark_push_iterator{ threaded_push_converter{ base16l | int8 | inflated(false), std::back_inserter(out), thread_boundaries<1>{} } };
+    *bad_it = "0123456789abcdef"_sp;
+    EXPECT_THROW(bad_it.finish(), std::runtime_error);
+}
+
+void parallel_convert_test()
+{
+    std::string input = make_test_input(10007, 131, 7);
+
+    auto sequential = [&input](auto chain) {
+        std::string result;
+        auto it = quark_push_iterator{ std::move(chain), std::back_inserter(result) };
+        *it = input;
+        it.finish();
+        return result;
+    };
+    auto as_string = [](auto const& v) { return std::string(v.begin(), v.end()); };
+
+    EXPECT_EQ(chain_chunk_alignment(*cvt_tuple_wrapper{ int8 | base64 }).input_block, 3u);
+    EXPECT_TRUE(as_string(parallel_convert(int8 | base64, input, 4, 64)) == sequential(int8 | base64)) << "ERROR in parallel_convert_test: base64";
+
+    auto ecb = [] { return int8 | aes(128, "0123456789abcdef"_bs, cipher_mode_type::ECB, ""_bs, padding_type::none) / int8 | base16l; };
+    input.resize(10000);
+    EXPECT_EQ(chain_chunk_alignment(*cvt_tuple_wrapper{ ecb() }).input_block, 16u);
+    EXPECT_TRUE(as_string(parallel_convert(ecb(), input, 3, 100)) == sequential(ecb())) << "ERROR in parallel_convert_test: aes ecb";
+
+    // chains that can't be split convert sequentially
+    EXPECT_FALSE(chain_chunk_alignment(*cvt_tuple_wrapper{ int8 | deflated(false, 256) | int8 }));
+    EXPECT_TRUE(as_string(parallel_convert(int8 | deflated(false, 256) | int8, input, 4, 64)) == sequential(int8 | deflated(false, 256) | int8))
+        << "ERROR in parallel_convert_test: deflate";
+
+    // a worker that throws is joined with the others and its exception rethrown
+    std::atomic<size_t> ran{ 0 };
+    EXPECT_THROW(run_on_workers(3, [&ran](size_t wi) {
+        ++ran;
+        if (wi != 1) throw std::runtime_error("worker failed");
+    }), std::runtime_error);
+    EXPECT_EQ(ran.load(), 3u);
+}
+
+void async_pull_test()
+{
+    std::string input;
+    for (size_t i = 0; i < 20000; ++i) input += "read ahead "[i % 11];
+
+
+    auto sync_it = quark_pull_iterator{ int8 | deflated(false, 256) | int8 | base64, input };
+    std::string const plain = collect_pulled(sync_it);
+
+    auto async_it = async_pull_iterator{ int8 | deflated(false, 256) | int8 | base64, input };
+    EXPECT_TRUE(collect_pulled(async_it) == plain) << "ERROR in async_pull_test";
+
+    auto small_it = async_pull_iterator{ int8 | deflated(false, 256) | int8 | base64, input, 100 };
+    EXPECT_TRUE(collect_pulled(small_it) == plain) << "ERROR in async_pull_test: small chunks";
+
+    // abandoned before the end
+    {
+        auto it = async_pull_iterator{ int8 | deflated(false, 256) | int8 | base64, input, 16 };
+        EXPECT_FALSE((*it).empty());
+    }
+
+    std::string const broken = "0123456789abcdef";
+    auto bad_it = async_pull_iterator{ base16l | int8 | inflated(false), broken };
+    EXPECT_THROW(collect_pulled(bad_it), std::runtime_error);
+
+    // the output pulled into a chunk before the failure is delivered before the exception
+    struct failing_source
+    {
+        size_t left = 3;
+        std::span<const char> next()
+        {
+            if (!left--) throw std::runtime_error("source failed");
+            return std::span{ "abc", 3 };
+        }
+    } source;
+    std::string partial;
+    auto failing_it = async_pull_iterator{ int8 | base64, std::ref(source), 1 << 20 };
+    EXPECT_THROW(
+        for (auto sp = *failing_it; !sp.empty(); sp = *failing_it) {
+            partial.append(reinterpret_cast<const char*>(sp.data()), sp.size());
+            ++failing_it;
+        }, std::runtime_error);
+    EXPECT_EQ(partial, "YWJjYWJjYWJj");
+}
+
+void mapped_file_test()
+{
+    std::string const input = make_test_input(3 * 4096 + 123, 7, 9);
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "dataforge_mapped_file_test.bin";
+    {
+        std::ofstream os{ path, std::ios::binary };
+        os.write(input.data(), static_cast<std::streamsize>(input.size()));
+    }
+
+    std::string const expected = collect_pulled(quark_pull_iterator{ int8 | base64, input });
+
+    // mapped at once
+    mapped_file_source whole{ path.string() };
+    EXPECT_EQ(whole.size(), input.size());
+    EXPECT_TRUE(collect_pulled(quark_pull_iterator{ int8 | base64, std::ref(whole) }) == expected) << "ERROR in mapped_file_test";
+
+    // mapped window by window
+    mapped_file_source windowed{ path.string(), mapped_file_options{ .window_bytes = 1, .max_mapped_bytes = 0 } };
+    EXPECT_TRUE(collect_pulled(quark_pull_iterator{ int8 | base64, std::ref(windowed) }) == expected) << "ERROR in mapped_file_test: windows";
+    windowed.rewind();
+    EXPECT_TRUE(collect_pulled(quark_pull_iterator{ int8 | base64, std::ref(windowed) }) == expected) << "ERROR in mapped_file_test: rewind";
+
+    std::filesystem::remove(path);
+    EXPECT_THROW(mapped_file_source{ path.string() }, std::runtime_error);
+}
+
+void fd_sink_test()
+{
+    std::string const input = make_test_input(5 * 4096 + 321, 13, 7);
+    std::string expected;
+    {
+        push_converter cvt{ int8 | base64, std::back_inserter(expected) };
+        cvt.push(span_cast<const uint8_t>(std::span{ input }));
+        cvt.finish();
+    }
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "dataforge_fd_sink_test.txt";
+    auto read_back = [&path] {
+        std::ifstream is{ path, std::ios::binary };
+        return std::string{ std::istreambuf_iterator<char>{ is }, std::istreambuf_iterator<char>{} };
+    };
+
+    auto convert = [&](file_sink_options const& opts, size_t piece) {
+        file_sink sink{ path.string(), opts };
+        push_converter cvt{ int8 | base64, std::ref(sink) };
+        for (size_t pos = 0; pos < input.size(); pos += piece) {
+            cvt.push(span_cast<const uint8_t>(std::span{ input }.subspan(pos, (std::min)(piece, input.size() - pos))));
+        }
+        cvt.finish(); // finishes the sink too
+        EXPECT_EQ(sink.bytes_written(), expected.size());
+        return read_back();
+    };
+
+    EXPECT_TRUE(convert({}, 100) == expected) << "ERROR in fd_sink_test: staged";
+    EXPECT_TRUE(convert({ .buffer_bytes = 64 }, input.size()) == expected) << "ERROR in fd_sink_test: writev";
+    EXPECT_TRUE(convert({ .buffer_bytes = 5000, .direct = true }, 777) == expected) << "ERROR in fd_sink_test: direct";
+
+    // the destructor writes what is left
+    {
+        file_sink sink{ path.string() };
+        sink.write("abc", 3);
+    }
+    EXPECT_EQ(read_back(), "abc");
+
+    std::filesystem::remove(path);
+    EXPECT_THROW(file_sink{ (path / "missing").string() }, std::runtime_error);
+
+    // a nested converter used as a consumer is finished by its owner only:
+    // finishing it with the outer chain too would add the digest of an empty message
+    std::string digests;
+    {
+        auto inner = quark_push_iterator{ int8 | sha256 | base16l, std::back_inserter(digests) };
+        push_converter outer{ int8 | base64, std::ref(inner) };
+        outer.push(span_cast<const uint8_t>(std::span{ std::string_view{ "abc" } }));
+        outer.finish();
+        inner.finish();
+    }
+    EXPECT_EQ(digests.size(), 64u);
+    static_assert(is_flushing_consumer_v<fd_sink> && !is_flushing_consumer_v<decltype(std::back_inserter(digests))>);
+}
+
+void uring_file_test()
+{
+    std::string const input = make_test_input(7 * 1000 + 55, 11, 8);
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "dataforge_uring_file_test.bin";
+
+    std::string const expected = collect_pulled(quark_pull_iterator{ int8 | base64, input });
+
+    // io_uring is used where it is compiled in and the kernel accepts a ring
+#if defined(DATAFORGE_HAS_IO_URING)
+    bool const have_io_uring = io_uring_queue{}.open(1);
+#else
+    bool const have_io_uring = false;
+#endif
+
+    for (bool use_io_uring : { true, false }) {
+        uring_file_options const opts{ .block_bytes = 1000, .queue_depth = 3, .use_io_uring = use_io_uring };
+        {
+            uring_file_sink sink{ path.string(), opts };
+            EXPECT_EQ(sink.uses_io_uring(), use_io_uring && have_io_uring);
+            push_converter cvt{ int8 | base16l / int8, std::ref(sink) };
+            for (size_t pos = 0; pos < input.size(); pos += 333) {
+                cvt.push(span_cast<const uint8_t>(std::span{ input }.subspan(pos, (std::min)(size_t{ 333 }, input.size() - pos))));
+            }
+            cvt.finish(); // waits for the writes
+            EXPECT_EQ(sink.bytes_written(), 2 * input.size());
+        }
+
+        uring_file_source src{ path.string(), opts };
+        EXPECT_EQ(src.uses_io_uring(), use_io_uring && have_io_uring);
+        EXPECT_EQ(src.size(), 2 * input.size());
+        EXPECT_TRUE(collect_pulled(quark_pull_iterator{ base16l | int8 / int8 | base64, std::ref(src) }) == expected) << "ERROR in uring_file_test";
+        src.rewind();
+        EXPECT_TRUE(collect_pulled(quark_pull_iterator{ base16l | int8 / int8 | base64, std::ref(src) }) == expected) << "ERROR in uring_file_test: rewind";
+    }
+
+    std::filesystem::remove(path);
+    EXPECT_THROW(uring_file_source{ path.string() }, std::runtime_error);
+}
+
+void bulk_append_test()
+{
+    std::string const input = make_test_input(10000, 5, 6);
+    auto const in = span_cast<const uint8_t>(std::span{ input });
+
+    // spans of all sizes into a string, a vector of another byte type, a list and a raw pointer
+    std::string const& expected = input;
+    std::string str;
+    std::vector<uint8_t> vec;
+    std::list<char> lst;
+    std::vector<char> raw(input.size());
+    std::u8string u8; // char8_t can't alias uint8_t, so the bytes are converted one by one
+    {
+        push_converter to_str{ int8 | buffer<uint8_t>(4096) / int8, std::back_inserter(str) };
+        push_converter to_u8{ int8 | buffer<uint8_t>(4096) / int8, std::back_inserter(u8) };
+        push_converter to_vec{ int8 | buffer<uint8_t>(4096) / int8, std::back_inserter(vec) };
+        push_converter to_lst{ int8 | buffer<uint8_t>(4096) / int8, std::back_inserter(lst) };
+        push_converter to_raw{ int8 | buffer<uint8_t>(4096) / int8, raw.data() };
+        for (size_t pos = 0, piece = 1; pos < in.size(); pos += piece, piece = piece * 3 % 1000 + 1) {
+            auto const sp = in.subspan(pos, (std::min)(piece, in.size() - pos));
+            to_str.push(sp);
+            to_u8.push(sp);
+            to_vec.push(sp);
+            to_lst.push(sp);
+            to_raw.push(sp);
+        }
+        to_str.finish();
+        to_u8.finish();
+        to_vec.finish();
+        to_lst.finish();
+        to_raw.finish();
+    }
+    EXPECT_EQ(str, expected);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end(), [](uint8_t a, char b) { return a == static_cast<uint8_t>(b); }));
+    EXPECT_TRUE(std::equal(lst.begin(), lst.end(), expected.begin(), expected.end()));
+    EXPECT_TRUE(std::equal(raw.begin(), raw.end(), expected.begin(), expected.end()));
+    EXPECT_TRUE(std::equal(u8.begin(), u8.end(), expected.begin(), expected.end(), [](char8_t a, char b) { return a == static_cast<char8_t>(b); }));
+
+    static_assert(push_converter_detail::may_alias_v<char, uint8_t> && push_converter_detail::may_alias_v<int16_t, uint16_t>);
+    static_assert(!push_converter_detail::may_alias_v<char8_t, uint8_t> && !push_converter_detail::may_alias_v<uint16_t, char16_t>);
+}
+
+void chunked_provider_test()
+{
+    std::string const input = make_test_input(3 * 4096 + 77, 3, 5);
+
+    std::string const expected = collect_pulled(quark_pull_iterator{ int8 | base16l, input });
+
+    // a random access source is asked once per block, not once per element
+    auto const same = std::views::transform(input, [](char c) { return c; });
+    pull_converter cvt{ int8 | base16l, same.begin(), same.end(), stage_instrumentation{} };
+    std::string result;
+    for (auto sp = cvt.pull(); !sp.empty(); sp = cvt.pull()) result.append(sp.begin(), sp.end());
+    EXPECT_TRUE(result == expected) << "ERROR in chunked_provider_test: gathered blocks";
+    EXPECT_LE(cvt.stats().stages[0].provider_calls, input.size() / 4096 + 2);
+
+    // a list is handed out element by element: gathering it only adds a copy
+    std::list<char> const lst(input.begin(), input.end());
+    EXPECT_TRUE(collect_pulled(quark_pull_iterator{ int8 | base16l, lst }) == expected) << "ERROR in chunked_provider_test: list";
+
+    std::deque<char> const deq(input.begin(), input.end());
+    EXPECT_TRUE(collect_pulled(quark_pull_iterator{ int8 | base16l, deq }) == expected) << "ERROR in chunked_provider_test: deque";
+
+    std::istringstream is{ input };
+    EXPECT_TRUE(collect_pulled(quark_pull_iterator{ pull_converter{ int8 | base16l, std::istreambuf_iterator<char>{ is }, std::istreambuf_iterator<char>{} } }) == expected)
+        << "ERROR in chunked_provider_test: istreambuf_iterator";
+
+    EXPECT_TRUE(collect_pulled(quark_pull_iterator{ pull_converter{ int8 | base16l, input.begin(), input.end() } }) == expected)
+        << "ERROR in chunked_provider_test: contiguous iterators";
+}
+
+void convert_test()
+{
+    std::string const input = make_test_input(10000, 7, 6);
+    auto via_iterator = [&input](auto chain) {
+        std::string result;
+        auto it = quark_push_iterator{ std::move(chain), std::back_inserter(result) };
+        *it = input;
+        it.finish();
+        return result;
+    };
+
+    // exact sizes
+    EXPECT_EQ(max_output_size(int8 | base64, 10), size_t{ 16 });
+    EXPECT_EQ(max_output_size(int8 | base16l, 10), size_t{ 20 });
+    EXPECT_EQ(max_output_size(int8 | aes(128, "0123456789abcdef"_bs, cipher_mode_type::CBC, "fedcba9876543210"_bs, padding_type::pkcs) / int8 | base16l, 32), size_t{ 96 });
+    EXPECT_EQ(max_output_size(base16l | int8, 10), std::nullopt);
+
+    EXPECT_EQ(convert<std::string>(int8 | base64, input), via_iterator(int8 | base64));
+    auto const encrypted = convert<std::string>(int8 | aes(128, "0123456789abcdef"_bs, cipher_mode_type::CBC, "fedcba9876543210"_bs, padding_type::pkcs) / int8 | base16l, input);
+    EXPECT_EQ(encrypted, via_iterator(int8 | aes(128, "0123456789abcdef"_bs, cipher_mode_type::CBC, "fedcba9876543210"_bs, padding_type::pkcs) / int8 | base16l));
+    EXPECT_EQ(encrypted.size(), (input.size() / 16 + 1) * 32);
+
+    // bounded sizes
+    auto const deflated_data = convert(int8 | deflated(false), input);
+    EXPECT_LE(deflated_data.size(), *max_output_size(int8 | deflated(false), input.size()));
+    EXPECT_EQ(convert<std::string>(int8 | inflated(false), deflated_data), input);
+    EXPECT_EQ(convert<std::string>(int8 | lz4() | int8, input), input);
+
+    // no size known: the container grows
+    std::string const hex = convert<std::string>(int8 | base16l, input);
+    EXPECT_EQ(convert<std::string>(base16l | int8, hex), input);
+
+    std::vector<char> buffer(*max_output_size(int8 | base64, input.size()));
+    auto const written = convert_into(int8 | base64, input, std::span{ buffer });
+    EXPECT_EQ(std::string(written.begin(), written.end()), via_iterator(int8 | base64));
+    EXPECT_THROW(convert_into(int8 | base64, input, std::span{ buffer }.first(100)), std::runtime_error);
+}
+
+void bounded_push_test()
+{
+    std::string const input = make_test_input(20000, 7, 6);
+    std::string const expected = convert<std::string>(int8 | deflated(false, 256) | int8 | base64, input);
+
+    for (size_t out_size : { 1, 7, 1000, 100000 }) {
+        bounded_push_converter cvt{ int8 | deflated(false, 256) | int8 | base64, 512 };
+        std::vector<char> out(out_size);
+        std::string result;
+        size_t max_pending = 0;
+        for (std::string_view rest = input; !rest.empty();) {
+            auto const [consumed, produced] = cvt.push(rest, std::span{ out });
+            EXPECT_TRUE(consumed || produced == out_size) << "ERROR in bounded_push_test: no progress";
+            rest.remove_prefix(consumed);
+            result.append(out.data(), produced);
+            max_pending = (std::max)(max_pending, cvt.pending());
+        }
+        do {
+            result.append(out.data(), cvt.finish(std::span{ out }));
+        } while (!cvt.finished());
+        EXPECT_TRUE(result == expected) << "ERROR in bounded_push_test, output buffer " << out_size;
+        EXPECT_LE(max_pending, size_t{ 2048 });
+    }
+
+    // reuse after reset
+    bounded_push_converter cvt{ int8 | base64 };
+    char out[64];
+    for (int i = 0; i < 2; ++i) {
+        auto const r = cvt.push(std::string_view{ "abcd" }, std::span{ out });
+        EXPECT_EQ(r.consumed, size_t{ 4 });
+        size_t const tail = cvt.finish(std::span{ out }.subspan(r.produced));
+        EXPECT_EQ(std::string(out, r.produced + tail), "YWJjZA==");
+        cvt.reset();
+    }
+}
+
+void tee_test()
+{
+    std::string const input = make_test_input(100000, 13, 9);
+
+    std::string const expected_digest = convert<std::string>(int8 | sha256 | base16l, input);
+    auto const expected_crc = convert(int8 | crc(crc32_type::DEFAULT), input);
+    auto const expected_packed = convert(int8 | deflated(false), input);
+
+    std::string digest;
+    std::vector<uint32_t> checksum;
+    std::vector<uint8_t> packed;
+    size_t packed_calls = 0;
+    push_converter cvt{ int8 | tee(int8 | sha256 | base16l, int8 | crc(crc32_type::DEFAULT), int8 | deflated(false)),
+        tee_consumer{ std::back_inserter(digest), std::back_inserter(checksum), [&packed, &packed_calls](auto const& data) {
+            ++packed_calls;
+            if constexpr (requires { data.size(); }) packed.insert(packed.end(), data.begin(), data.end());
+            else packed.push_back(data);
+        } } };
+    for (size_t pos = 0; pos < input.size(); pos += 1000) {
+        cvt.push(span_cast<const uint8_t>(std::span{ input }.subspan(pos, (std::min)(size_t{ 1000 }, input.size() - pos))));
+    }
+    cvt.finish();
+
+    EXPECT_EQ(digest, expected_digest);
+    EXPECT_TRUE(checksum == expected_crc) << "ERROR in tee_test: crc32 branch";
+    EXPECT_TRUE(packed == expected_packed) << "ERROR in tee_test: deflate branch";
+    EXPECT_GT(packed_calls, size_t{ 0 });
+
+    // the branches start over after reset
+    digest.clear();
+    checksum.clear();
+    packed.clear();
+    cvt.reset();
+    cvt.push(span_cast<const uint8_t>(std::span{ input }));
+    cvt.finish();
+    EXPECT_EQ(digest, expected_digest);
+    EXPECT_TRUE(checksum == expected_crc) << "ERROR in tee_test: crc32 branch after reset";
+    EXPECT_TRUE(packed == expected_packed) << "ERROR in tee_test: deflate branch after reset";
+}
+
+void batched_push_test()
+{
+    std::vector<uint8_t> input(5000);
+    for (size_t i = 0; i < input.size(); ++i) input[i] = static_cast<uint8_t>(i * 31 + (i >> 7));
+    std::string const expected = convert<std::string>(int8 | deflated(false) | int8 | base64, input);
+
+    // single elements, short and long spans, mixed
+    auto feed = [&input](auto& cvt) {
+        size_t pos = 0;
+        for (size_t step = 0; pos < input.size(); ++step) {
+            size_t const n = (std::min)(input.size() - pos, step % 3 == 0 ? size_t{ 1 } : (step % 3 == 1 ? size_t{ 37 } : size_t{ 700 }));
+            if (n == 1) cvt.push(input[pos]);
+            else cvt.push(std::span<const uint8_t>{ input.data() + pos, n });
+            pos += n;
+        }
+        cvt.finish();
+    };
+
+    std::string result;
+    batched_push_converter<uint8_t> batched{ int8 | deflated(false) | int8 | base64, std::back_inserter(result) };
+    feed(batched);
+    EXPECT_EQ(result, expected);
+
+    std::string heap_result;
+    batched_push_converter<uint8_t, 16, 64> heap{ int8 | deflated(false) | int8 | base64, std::back_inserter(heap_result) };
+    EXPECT_FALSE(heap.is_inline());
+    feed(heap);
+    EXPECT_EQ(heap_result, expected);
+
+    // batched input moves with the converter
+    std::string moved_result;
+    batched_push_converter<uint8_t> src{ int8 | base64, std::back_inserter(moved_result) };
+    src.push(uint8_t{ 'a' });
+    src.push(uint8_t{ 'b' });
+    EXPECT_TRUE(src.is_inline());
+    batched_push_converter<uint8_t> dst{ std::move(src) };
+    EXPECT_TRUE(dst.is_inline());
+    dst.push(uint8_t{ 'c' });
+    dst.finish();
+    EXPECT_EQ(moved_result, "YWJj");
+}
+
+void runtime_pipeline_test()
+{
+    std::string input;
+    for (size_t i = 0; i < 200000; ++i) input += static_cast<char>('a' + (i * i + (i >> 5)) % 26);
+    std::string const key = "0123456789abcdef0123456789abcdef";
+    std::string const iv = "fedcba9876543210";
+    pipeline_params const params{ { "key", key }, { "iv", iv } };
+
+    pipeline_registry reg;
+    register_standard_stages(reg);
+
+    // deflate|aes|base64 is a fused stage
+    EXPECT_EQ(reg.build("utf8|deflate:6|aes:256:ctr|base64", params).size(), size_t{ 2 });
+    EXPECT_EQ(reg.build("deflate:6 | base16 | base16-decode | inflate").size(), size_t{ 4 });
+
+    std::string const expected = convert<std::string>(
+        int8 | deflated(false, 65536, 6) / int8 | aes(128, key, cipher_mode_type::CTR, iv, padding_type::none) / int8 | base64, input);
+    std::string encoded;
+    auto cvt = reg.push_pipeline("utf8|deflate:6|aes:256:ctr|base64", std::back_inserter(encoded), params);
+    for (size_t pos = 0; pos < input.size(); pos += 3000) {
+        cvt.push(span_cast<const uint8_t>(std::span{ input }.subspan(pos, (std::min)(size_t{ 3000 }, input.size() - pos))));
+    }
+    cvt.finish();
+    EXPECT_TRUE(encoded == expected) << "ERROR in runtime_pipeline_test: push pipeline";
+
+    std::string decoded;
+    auto pull = reg.pull_pipeline("base64-decode|aes-decrypt:256:ctr|inflate", std::span{ encoded }, params);
+    for (auto sp = pull.pull(); !sp.empty(); sp = pull.pull()) decoded.append(sp.begin(), sp.end());
+    EXPECT_TRUE(decoded == input) << "ERROR in runtime_pipeline_test: pull pipeline";
+
+    // separate stages
+    std::string roundtrip;
+    auto sep = reg.push_pipeline("deflate | base16 | base16-decode | inflate", std::back_inserter(roundtrip));
+    sep.push(span_cast<const uint8_t>(std::span{ input }));
+    sep.finish();
+    EXPECT_TRUE(roundtrip == input) << "ERROR in runtime_pipeline_test: separate stages";
+
+    EXPECT_THROW(reg.build("deflate|rot13"), std::runtime_error);
+    EXPECT_THROW(reg.build("deflate:fast"), std::runtime_error);
+    EXPECT_THROW(reg.build("deflate||base64"), std::runtime_error);
+    EXPECT_THROW(reg.build("aes:256:ctr"), std::runtime_error);
+}
+
 }
 
 #endif // DATAFORGE_TEST_FULL_SUITE
@@ -199,6 +199,28 @@ void dataforge_pull_test(ConverterChainT enc, IRangeT && input, RRangeT expected
 #define DATAFORGE_PULL_TEST(conv, rng, exp) dataforge_pull_test(conv, rng, exp, #conv)
 #define DATAFORGE_TEST(conv, rng, exp) dataforge_push_test(conv, rng, exp, #conv); dataforge_pull_test(conv, rng, exp, #conv)
 
+// size bytes that don't repeat with a short period: i * mul + (i >> shift)
+inline std::string make_test_input(size_t size, size_t mul, unsigned shift)
+{
+    std::string input;
+    input.reserve(size);
+    for (size_t i = 0; i < size; ++i) input += static_cast<char>(i * mul + (i >> shift));
+    return input;
+}
+
+// the concatenated spans of a pull iterator up to the empty one; an lvalue
+// iterator is left at the end
+template <typename PullIteratorT>
+std::string collect_pulled(PullIteratorT&& it)
+{
+    std::string result;
+    for (auto sp = *it; !sp.empty(); sp = *it) {
+        result.append(reinterpret_cast<const char*>(sp.data()), sp.size());
+        ++it;
+    }
+    return result;
+}
+
 template <typename ConverterT, typename TestSetT>
 void conv_push_test_set(ConverterT enc, TestSetT const& ts, std::string const& descr = "")
 {
@@ -250,6 +272,7 @@ void md6_test();
 void ripemd_test();
 void sha1_test();
 void sha2_test();
+void backend_report_test();
 void sha3_test();
 void tiger_test();
 void gost_test();
@@ -257,6 +280,13 @@ void streebog_test();
 void belt_hash_test();
 void whirlpool_test();
 void blake_test();
+void hmac_test();
+void midstate_test();
+void pbkdf2_test();
+void hkdf_test();
+void merkle_test();
+void fixed_digest_test();
+void autotune_test();
 
 void blowfish_test();
 void rc2_test();
@@ -274,5 +304,20 @@ void deflate_test();
 void bzip2_test();
 void lzma_test();
 void lz4_test();
+void instrumentation_test();
+void stage_major_test();
+void threaded_test();
+void parallel_convert_test();
+void async_pull_test();
+void mapped_file_test();
+void fd_sink_test();
+void uring_file_test();
+void bulk_append_test();
+void chunked_provider_test();
+void convert_test();
+void bounded_push_test();
+void tee_test();
+void batched_push_test();
+void runtime_pipeline_test();
 
 }
@@ -7,6 +7,8 @@
 ==============================================================================*/
 #include "test_common.hpp"
 
+#include <filesystem>
+
 #include "dataforge/hashes/gost.hpp"
 #include "dataforge/hashes/streebog.hpp"
 #include "dataforge/hashes/belt.hpp"
@@ -21,7 +23,14 @@
 #include "dataforge/hashes/ripemd.hpp"
 #include "dataforge/hashes/whirlpool.hpp"
 #include "dataforge/hashes/blake.hpp"
+#include "dataforge/hashes/hmac.hpp"
+#include "dataforge/hashes/midstate.hpp"
+#include "dataforge/hashes/pbkdf2.hpp"
+#include "dataforge/hashes/hkdf.hpp"
+#include "dataforge/hashes/merkle.hpp"
 #include "dataforge/base_xx/base16.hpp"
+#include "dataforge/backend_report.hpp"
+#include "dataforge/autotune.hpp"
 
 using namespace std::literals::string_view_literals;
 
@@ -151,6 +160,62 @@ void sha2_test()
     DATAFORGE_TEST(int8 | sha512 | base16u, example0, "07E547D9586F6A73F73FBAC0435ED76951218FB7D0C8D788A309D785436BBB642E93A252A954F23912547D1E8A3B5ED6E1BFD7097821233FA0538F3DB854FEE6"sv);
     DATAFORGE_TEST(int8 | sha512_224 | base16u, example0, "944CD2847FB54558D4775DB0485A50003111C8E5DAA63FE722C6AA37"sv);
     DATAFORGE_TEST(int8 | sha512_256 | base16u, example0, "DD9D67B371519C339ED8DBD25AF90E976A1EEEFD4AD3D889005E532FC5BEF04D"sv);
+
+    // multi-block inputs: even and odd block counts reach the backends in one call
+    std::string example1(1000000, 'a');
+    DATAFORGE_TEST(int8 | sha384 | base16u, example1, "9D0E1809716474CB086E834E310A4A1CED149E9C00F248527972CEC5704C2A5B07B8B3DC38ECC4EBAE97DDD87F3D8985"sv);
+    DATAFORGE_TEST(int8 | sha512 | base16u, example1, "E718483D0CE769644E2E42C7BC15B4638E1F98B13B2044285632A803AFA973EBDE0FF244877EA60A4CB0432CE577C31BEB009C5C2C49AA2E4EADB217AD8CC09B"sv);
+    std::string example2(3 * 128 + 17, 'a');
+    DATAFORGE_TEST(int8 | sha384 | base16u, example2, "213392F362904301DD018BAEF336E30E073341FB2A7B8DB3ABB59C06C706BFE4836919BABB74552EB4FEB58A2517405C"sv);
+    DATAFORGE_TEST(int8 | sha512 | base16u, example2, "A2FAC0F98FD9C0D3C4CD75DE4F1F7615F57819DCED6D222A440EC675DE3B114C8E2B2C322E0709A3411E2DA4D681B080F1B644A3A4F584F6E55E3118F368BA3D"sv);
+
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE
+    // every SHA-512 backend the CPU runs, not just the preferred one, against
+    // the scalar rounds on odd and even block counts
+    std::string const blocks = make_test_input(7 * 128, 29, 3);
+    for (auto const& backend : sha2_detail::sha512_backend_candidates()) {
+        for (size_t count = 1; count <= 7; ++count) {
+            uint64_t expected[8], state[8];
+            for (size_t i = 0; i < 8; ++i) expected[i] = state[i] = 0x0123456789abcdefull * (i + 1);
+            sha2_detail::sha2_impl<sha2_type::sha512>::process_blocks_scalar(expected, blocks.data(), count);
+            backend.fn(state, blocks.data(), count);
+            EXPECT_TRUE(std::equal(state, state + 8, expected)) << "ERROR in sha2_test: " << backend.name << " backend, " << count << " blocks";
+        }
+    }
+#endif
+}
+
+void backend_report_test()
+{
+    auto report = backend_report();
+    auto backend_of = [&report](std::string_view algorithm) {
+        auto it = std::find_if(report.begin(), report.end(), [algorithm](backend_entry const& e) { return e.algorithm == algorithm; });
+        return it == report.end() ? std::string_view{ "<none>" } : it->backend;
+    };
+    EXPECT_TRUE(std::is_sorted(report.begin(), report.end(), [](auto const& l, auto const& r) { return l.algorithm < r.algorithm; }));
+    EXPECT_NE(backend_of("sha1"), "<none>");
+    EXPECT_NE(backend_of("sha224/256"), "<none>");
+    EXPECT_NE(backend_of("sha384/512"), "<none>");
+    EXPECT_NE(backend_of("streebog"), "<none>");
+
+#if DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_NONE
+    for (backend_entry const& e : report) {
+        EXPECT_EQ(e.backend, "scalar") << e.algorithm;
+    }
+#elif DATAFORGE_ACCEL_IMPL == DATAFORGE_ACCEL_AUTODETECT_MODE && DATAFORGE_TARGET_X86 && DATAFORGE_ACCEL_CAN_COMPILE_X86_SHA1
+    EXPECT_EQ(backend_of("sha1"), cpu_has(cpu_feature::x86_sha) ? "sha-ni" : "scalar");
+#endif
+
+    // a scalar tier cap hides every detected feature
+    cpu_feature_registry scalar_only{ "scalar" };
+    EXPECT_EQ(scalar_only.tier_cap(), "scalar");
+    for (unsigned f = 0; f < static_cast<unsigned>(cpu_feature::count); ++f) {
+        EXPECT_FALSE(scalar_only.has(static_cast<cpu_feature>(f))) << cpu_feature_registry::name(static_cast<cpu_feature>(f));
+    }
+    cpu_feature_registry uncapped;
+    for (unsigned f = 0; f < static_cast<unsigned>(cpu_feature::count); ++f) {
+        EXPECT_EQ(uncapped.has(static_cast<cpu_feature>(f)), uncapped.detected(static_cast<cpu_feature>(f)));
+    }
 }
 
 #endif // DATAFORGE_TEST_FULL_SUITE || DATAFORGE_TEST_HAS_SHA_ACCEL
@@ -258,6 +323,15 @@ void streebog_test()
     DATAFORGE_TEST(base16l | int8 | streebog512 | base16l,
         "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"sv,
         "b0fd29ac1b0df441769ff3fdb8dc564df67721d6ac06fb28ceffb7bbaa7948c6c014ac999235b58cb26fb60fb112a145d7b4ade9ae566bf2611402c552d20db7"sv);
+
+    // multi-block inputs; all-ones words exercise the carry chain of the 512-bit Sigma addition
+    std::vector<char> a1000000(1000000, 'a');
+    DATAFORGE_TEST(int8 | streebog256 | base16l, a1000000, "841af1a0b2f92a800fb1b7e4aabc8e48763153c448a0fc57c90ba830e130f152"sv);
+    DATAFORGE_TEST(int8 | streebog512 | base16l, a1000000, "d396a40b126b1f324465bfa7aa159859ab33fac02dcdd4515ad231206396a266d0102367e4c544ef47d2294064e1a25342d0cd25ae3d904b45abb1425ae41095"sv);
+
+    std::vector<unsigned char> ff197(197, 0xff);
+    DATAFORGE_TEST(int8 | streebog256 | base16l, ff197, "9a63861e0cfe46e8dd6f7c92295ce061667077361bd4e115505bd272ac89570b"sv);
+    DATAFORGE_TEST(int8 | streebog512 | base16l, ff197, "368d6484aeaa14867d0bbceeed6cbf3981ca4ca2eb903e9d136b2419761ec0cf16231a63dcbe6745660d87940481895bdd20b90b791943c1e00ca9da9be55e21"sv);
 }
 
 void whirlpool_test()
@@ -337,6 +411,221 @@ void blake_test()
     DATAFORGE_TEST(int8 | blake2s224_t("1"_bs, nullptr) | base16l, x64, "bbd56c7c818bd42519f86a09de65f82435bba62c7afeb83c48d48cb4"sv);
 }
 
+void hmac_test()
+{
+    // RFC 4231
+    std::vector<unsigned char> key20(20, 0x0b), key131(131, 0xaa);
+    DATAFORGE_TEST(int8 | hmac(sha256, key20) | base16l, "Hi There"sv, "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"sv);
+    DATAFORGE_TEST(int8 | hmac(sha256, "Jefe"_bs) | base16l, "what do ya want for nothing?"sv, "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"sv);
+    DATAFORGE_TEST(int8 | hmac(sha256, key131) | base16l, "Test Using Larger Than Block-Size Key - Hash Key First"sv, "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"sv);
+    DATAFORGE_TEST(int8 | hmac(sha256, key131) | base16l, "This is a test using a larger than block-size key and a larger than block-size data. The key needs to be hashed before being used by the HMAC algorithm."sv, "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2"sv);
+    DATAFORGE_TEST(int8 | hmac(sha512, key131) | base16l, "Test Using Larger Than Block-Size Key - Hash Key First"sv, "80b24263c7c1a3ebb71493c1dd7be8b49b46d1f41b4aeec1121b013783f8f3526b56d037e05f2598bd0fd2215d6a1e5295e64f73f63f0aec8b915a985d786598"sv);
+    DATAFORGE_TEST(int8 | hmac(sha256, cbyte_span_t{}) | base16l, ""sv, "b613679a0814d9ec772f95d778c35fc5ff1697c493715653c6c712144292c5ad"sv);
+
+    DATAFORGE_TEST(int8 | hmac(sha1, "Jefe"_bs) | base16l, "what do ya want for nothing?"sv, "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79"sv);
+    DATAFORGE_TEST(int8 | hmac(md5, "key"_bs) | base16l, "The quick brown fox jumps over the lazy dog"sv, "80070713463e7749b90c2dc24911e275"sv);
+    DATAFORGE_TEST(int8 | hmac(sha3_256, "Jefe"_bs) | base16l, "what do ya want for nothing?"sv, "c7d4072e788877ae3596bbb0da73b887c9171f93095b294ae857fbe2645e1ba5"sv);
+
+    // RFC 7836
+    std::vector<unsigned char> key32(32);
+    for (size_t i = 0; i < key32.size(); ++i) key32[i] = static_cast<unsigned char>(i);
+    DATAFORGE_TEST(base16l | int8 | hmac(streebog256, key32) | base16l, "0126bdb87800af214341456563780100"sv, "a1aa5f7de402d7b3d323f2991c8d4534013137010a83754fd0af6d7cd4922ed9"sv);
+    DATAFORGE_TEST(base16l | int8 | hmac(streebog512, key32) | base16l, "0126bdb87800af214341456563780100"sv, "a59bab22ecae19c65fbde6e5f4e9f5d8549d31f037f9df9b905500e171923a773d5f1530f2ed7e964cb2eedc29e9ad2f3afe93b2814f79f5000ffc0366c251e6"sv);
+
+    // the converter starts every message from the cached inner midstate
+    std::string result;
+    auto cvt_it = quark_push_iterator{ int8 | hmac(sha256, "Jefe"_bs) | base16l, std::back_inserter(result) };
+    *cvt_it = "what do ya "_sp;
+    *cvt_it = "want for nothing?"_sp;
+    cvt_it.finish();
+    *cvt_it = "what do ya want for nothing?"_sp;
+    cvt_it.finish();
+    EXPECT_TRUE(equal_to(result, "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"
+                                 "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"sv)) << "ranges are different";
+}
+
+template <typename QuarkT>
+void digest_reuse_test(QuarkT const& digest, std::string_view input, std::string_view expected)
+{
+    std::string result;
+    auto cvt_it = quark_push_iterator{ int8 | digest | base16l, std::back_inserter(result) };
+    *cvt_it = input;
+    cvt_it.finish();
+    *cvt_it = input;
+    cvt_it.finish();
+    EXPECT_TRUE(equal_to(result, std::string{ expected } + std::string{ expected })) << "the digest state was not reset by finish()";
+}
+
+template <typename IteratorT, typename StateT>
+concept midstate_restorable = requires(IteratorT& it, StateT const& st) { restore(it, st); };
+
+void midstate_test()
+{
+    // the midstate is taken mid-block, so the partial buffer and the length counter travel with it
+    std::string result;
+    auto cvt_it = quark_push_iterator{ int8 | sha256 | base16l, std::back_inserter(result) };
+    *cvt_it = "header-"_sp;
+    auto const header_state = snapshot(cvt_it);
+    *cvt_it = "doc1"_sp;
+    cvt_it.finish();
+    restore(cvt_it, header_state);
+    *cvt_it = "doc2"_sp;
+    cvt_it.finish();
+    EXPECT_TRUE(equal_to(result, "d47f0764b8b9198820dc724ae8ff0e866299ad8d6259421e5c7b9e353531a7f7"
+                                 "13868168d7daaa0073a0c86adb80a4ce6b0c735d5afcf86e5babf1769e4b9d4d"sv)) << "ranges are different";
+
+    // a pipeline built from the midstate returns to it after every message
+    DATAFORGE_TEST(int8 | from_midstate(sha256, header_state) | base16l, "doc1"sv, "d47f0764b8b9198820dc724ae8ff0e866299ad8d6259421e5c7b9e353531a7f7"sv);
+    DATAFORGE_TEST(int8 | from_midstate(sha256, header_state) | base16l, "doc2"sv, "13868168d7daaa0073a0c86adb80a4ce6b0c735d5afcf86e5babf1769e4b9d4d"sv);
+
+    result.clear();
+    auto hmac_it = quark_push_iterator{ int8 | hmac(sha256, "key"_bs) | base16l, std::back_inserter(result) };
+    *hmac_it = "header-"_sp;
+    auto const hmac_state = snapshot(hmac_it);
+    static_assert(!midstate_restorable<decltype(hmac_it), decltype(header_state)>, "a plain digest midstate must not restore into an hmac converter");
+    static_assert(!midstate_restorable<decltype(cvt_it), decltype(hmac_state)>, "an hmac midstate must not restore into a plain digest converter");
+    auto resumed_it = quark_push_iterator{ int8 | from_midstate(hmac(sha256, "key"_bs), hmac_state) | base16l, std::back_inserter(result) };
+    *resumed_it = "doc1"_sp;
+    resumed_it.finish();
+    *resumed_it = "doc2"_sp;
+    resumed_it.finish();
+    EXPECT_TRUE(equal_to(result, "0207f8172d1cf76993842cc2d9f55bf5d6ec749eb200c716a6ba53e1da778e08"
+                                 "cdad54d36d804277a6a94e1ef919eece228948ca1f6eafb1f0d25b7226ee762a"sv)) << "ranges are different";
+
+    digest_reuse_test(streebog256, "abc"sv, "4e2919cf137ed41ec4fb6270c61826cc4fffb660341e0af3688cd0626d23b481"sv);
+    digest_reuse_test(ripemd160, "abc"sv, "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc"sv);
+    digest_reuse_test(gost, "abc"sv, "f3134348c44fb1b2a277729e2285ebb5cb5e0f29c975bc753b70497c06a4d51d"sv);
+    digest_reuse_test(belt_hash, "abc"sv, "2661a79795a9e80258d6bc1e5d11747247901268ec4cd19237aad051e322b0c2"sv);
+}
+
+void pbkdf2_test()
+{
+    // RFC 6070
+    DATAFORGE_TEST(int8 | pbkdf2(sha1, "salt"_bs, 1, 20) | base16l, "password"sv, "0c60c80f961f0e71f3a9b524af6012062fe037a6"sv);
+    DATAFORGE_TEST(int8 | pbkdf2(sha1, "salt"_bs, 4096, 20) | base16l, "password"sv, "4b007901b765489abead49d926f721d065a429c1"sv);
+    DATAFORGE_TEST(int8 | pbkdf2(sha1, "saltSALTsaltSALTsaltSALTsaltSALTsalt"_bs, 4096, 25) | base16l, "passwordPASSWORDpassword"sv, "3d2eec4fe41c849b80c8d83662c0e44a8b291a964cf2f07038"sv);
+    DATAFORGE_TEST(int8 | pbkdf2(sha1, "sa\0lt"_bs, 4096, 16) | base16l, "pass\0word"sv, "56fa6aa75548099dcc37d7f03425e0c3"sv);
+
+    DATAFORGE_TEST(int8 | pbkdf2(sha256, "salt"_bs, 4096, 32) | base16l, "password"sv, "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a"sv);
+    DATAFORGE_TEST(int8 | pbkdf2(sha256, "saltSALTsaltSALTsaltSALTsaltSALTsalt"_bs, 4096, 40) | base16l, "passwordPASSWORDpassword"sv, "348c89dbcbd32b2f32d814b8116e84cf2b17347ebc1800181c4e2a1fb8dd53e1c635518c7dac47e9"sv);
+    DATAFORGE_TEST(int8 | pbkdf2(sha512, "salt"_bs, 1000, 130) | base16l, "password"sv, "afe6c5530785b6cc6b1c6453384731bd5ee432ee549fd42fb6695779ad8a1c5bf59de69c48f774efc4007d5298f9033c0241d5ab69305e7b64eceeb8d834cfec6afdec3c1c23982a121f2d4be008889378a49a0dfb104f0d2856e38f44271cdaf6de434196647bc5673cd6c148611ced6e9003b65879feccc89226ecc5e220907954"sv);
+    DATAFORGE_TEST(int8 | pbkdf2(md5, "salt"_bs, 1000, 40) | base16l, "password"sv, "8d189946a32d883622a16ae18af0632f5791d5e7b1abb0ab1757d28ce34056140335105994495f91"sv);
+    DATAFORGE_TEST(int8 | pbkdf2(ripemd160, "salt"_bs, 100, 20) | base16l, "password"sv, "d22022689f0cc2e6f621b5e49801c99b08b73293"sv);
+    // no one-block fast path for sponge digests
+    DATAFORGE_TEST(int8 | pbkdf2(sha3_256, "salt"_bs, 100, 50) | base16l, "password"sv, "3662b9455cde6979b1d5d866df806e1fe15954073e07c7c2acf2c80205074e46d2226ae0253297f80a7dc846471882a3d88e"sv);
+}
+
+void hkdf_test()
+{
+    // RFC 5869
+    std::vector<unsigned char> ikm22(22, 0x0b), ikm11(11, 0x0b), ikm80(80), salt13(13), salt80(80), info10(10), info80(80);
+    for (size_t i = 0; i < 80; ++i) {
+        ikm80[i] = static_cast<unsigned char>(i);
+        salt80[i] = static_cast<unsigned char>(0x60 + i);
+        info80[i] = static_cast<unsigned char>(0xb0 + i);
+    }
+    for (size_t i = 0; i < 13; ++i) salt13[i] = static_cast<unsigned char>(i);
+    for (size_t i = 0; i < 10; ++i) info10[i] = static_cast<unsigned char>(0xf0 + i);
+
+    DATAFORGE_TEST(int8 | hkdf(sha256, salt13, info10, 42) | base16l, ikm22, "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865"sv);
+    DATAFORGE_TEST(int8 | hkdf(sha256, salt80, info80, 82) | base16l, ikm80, "b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c59045a99cac7827271cb41c65e590e09da3275600c2f09b8367793a9aca3db71cc30c58179ec3e87c14c01d5c1f3434f1d87"sv);
+    DATAFORGE_TEST(int8 | hkdf(sha256, cbyte_span_t{}, cbyte_span_t{}, 42) | base16l, ikm22, "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d9d201395faa4b61a96c8"sv);
+    DATAFORGE_TEST(int8 | hkdf(sha1, salt13, info10, 42) | base16l, ikm11, "085a01ea1b10f36933068b56efa5ad81a4f14b822f5b091568a9cdd4f155fda2c22e422478d305f3f896"sv);
+}
+
+void merkle_test()
+{
+    // leaves abcd efgh ijkl m; the single node left over at a level is carried up as is,
+    // which for arity 2 gives the RFC 6962 tree
+    DATAFORGE_TEST(int8 | merkle(sha256, 4) | base16l, "abcdefghijklm"sv, "38440900411cb3a6195d15613b63f266dc34d3ff5760e14d0f6885b1229eeae0"sv);
+    DATAFORGE_TEST(int8 | merkle(sha256, 4, 3) | base16l, "abcdefghijklm"sv, "a59c61c4d983f7e8c07b89b546c05971d84caf0cf5362834838b00f7a3445e5b"sv);
+    DATAFORGE_TEST(int8 | merkle(sha256, 3, 4) | base16l, "abcdefghijklmnopqrstuvwxyz0123"sv, "882a3d8cd1e33e070e4d3425ffa38aa2528f5a257f445c3cdd8d27b265e89519"sv);
+    DATAFORGE_TEST(int8 | merkle(sha1, 4) | base16l, "abcdefghijklm"sv, "4d201e40fa7fe7e44a7064c5a58e9ea482ebd926"sv);
+    // a one-chunk root is the leaf hash sha256(00 'abc'); an empty input hashes to sha256()
+    DATAFORGE_TEST(int8 | merkle(sha256, 4) | base16l, "abc"sv, "609f6e36d2405585188d5cfd761f407c7cc46a7d3f314c88270469dde315fcd1"sv);
+    DATAFORGE_TEST(int8 | merkle(sha256, 4) | base16l, ""sv, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"sv);
+    DATAFORGE_TEST(int8 | merkle(sha256, 4, 2, merkle_output::leaves_and_root) | base16l, "abcdefghijklm"sv,
+        "b4768f09ca070169db2f5962745531650515dbd00ea5bf393cd88fec601d598a"
+        "3aac0bdbaff34540d716868ea9c743cd667dfbb1b46d30f9bbbec7ed16415e44"
+        "0b3aa8fdaed803923a12352972617714e5ad44472c0bbcc78b2f12ebb4772b3c"
+        "8c941a526a0adc76166600d48309556769aac616405011874d3ca7c2048064e7"
+        "38440900411cb3a6195d15613b63f266dc34d3ff5760e14d0f6885b1229eeae0"sv);
+
+    std::vector<unsigned char> data(1000000);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<unsigned char>(i * 7 + i / 251);
+    DATAFORGE_TEST(int8 | merkle(sha256, 1000) | base16l, data, "621fd9eaed20b3a181e8595988c189ea2dcfd7b63162fc27423f849d946522cc"sv);
+    DATAFORGE_TEST(int8 | merkle(sha256, 4096, 16) | base16l, data, "c3a83e88aee1199e1a9541444ab3278b1ac3a4253200479a267a4d67634d8625"sv);
+    DATAFORGE_TEST(int8 | merkle(sha256, 300000) | base16l, data, "d6f56f52b29baf1d8e7b422796cd7b305cafc2972e370a9fde5adf186b5a78d7"sv);
+}
+
+template <size_t N, typename QuarkT, typename FixedT>
+void fixed_digest_check(QuarkT const& digest, FixedT fixed)
+{
+    std::array<unsigned char, N + 1> data;
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<unsigned char>(i * 13 + 1);
+    std::vector<unsigned char> expected;
+    auto cvt_it = quark_push_iterator{ int8 | digest, std::back_inserter(expected) };
+    *cvt_it = std::span{ data.data(), N };
+    cvt_it.finish();
+    EXPECT_TRUE(equal_to(fixed(data.data()), expected)) << "fixed-length digest of " << N << " bytes differs";
+}
+
+void fixed_digest_test()
+{
+    // lengths around the one-block / two-block padding boundary
+    fixed_digest_check<0>(sha256, sha256_fixed<0>);
+    fixed_digest_check<32>(sha256, sha256_fixed<32>);
+    fixed_digest_check<55>(sha256, sha256_fixed<55>);
+    fixed_digest_check<56>(sha256, sha256_fixed<56>);
+    fixed_digest_check<64>(sha256, sha256_fixed<64>);
+    fixed_digest_check<56>(sha224, sha224_fixed<56>);
+    fixed_digest_check<111>(sha512, sha512_fixed<111>);
+    fixed_digest_check<112>(sha512, sha512_fixed<112>);
+    fixed_digest_check<96>(sha384, sha384_fixed<96>);
+    fixed_digest_check<20>(sha1, sha1_fixed<20>);
+    fixed_digest_check<16>(md5, md5_fixed<16>);
+    fixed_digest_check<40>(ripemd160, [](const void* p) { return digest_fixed<40>(ripemd160, p); });
+}
+
+void autotune_test()
+{
+    // two fake kernels returning their cost in ticks of a fake clock: each one
+    // is slow on the size class the other is fast on
+    using fn_t = size_t(*)(size_t);
+    fn_t const large = [](size_t n) { return n < 4 ? 100 * n : n; };
+    fn_t const small = [](size_t n) { return n < 4 ? n : 100 * n; };
+    std::vector<accel_backend<fn_t>> const candidates{ { large, "large" }, { small, "small" } };
+    size_t bench_calls = 0;
+    std::chrono::steady_clock::time_point fake_now;
+    auto bench = [&](fn_t fn, const void*, size_t n) { ++bench_calls; fake_now += std::chrono::microseconds(fn(n)); };
+
+    autotune_settings off;
+    tuned_backend<fn_t> untuned{ "fake", candidates[0], candidates, 64, bench, true, off };
+    EXPECT_EQ(bench_calls, 0u);
+    EXPECT_EQ(untuned.name(), "large");
+
+    std::string const wisdom = (std::filesystem::temp_directory_path() / "dataforge_wisdom_test.txt").string();
+    std::filesystem::remove(wisdom);
+    autotune_settings on;
+    on.enabled = true;
+    on.wisdom_path = wisdom;
+    on.now = [&fake_now] { return fake_now; };
+    tuned_backend<fn_t> tuned{ "fake", candidates[0], candidates, 64, bench, true, on };
+    EXPECT_NE(bench_calls, 0u);
+    EXPECT_EQ(tuned(1).name, "small");
+    EXPECT_EQ(tuned(3).name, "small");
+    EXPECT_EQ(tuned(4).name, "large");
+    EXPECT_EQ(tuned(1000).name, "large");
+    EXPECT_EQ(tuned.name(), "small (1-3 blocks), large (4+ blocks)");
+
+    // the second instance reads the wisdom file instead of measuring
+    bench_calls = 0;
+    tuned_backend<fn_t> reloaded{ "fake", candidates[0], candidates, 64, bench, true, on };
+    EXPECT_EQ(bench_calls, 0u);
+    EXPECT_EQ(reloaded.name(), tuned.name());
+    std::filesystem::remove(wisdom);
+}
+
 #endif // DATAFORGE_TEST_FULL_SUITE
 
 }
@@ -16,6 +16,7 @@ using namespace dataforge;
 #if DATAFORGE_TEST_FULL_SUITE || DATAFORGE_TEST_HAS_SHA_ACCEL
 TEST(DataforgeTest, sha1) { sha1_test(); }
 TEST(DataforgeTest, sha2) { sha2_test(); }
+TEST(DataforgeTest, backend_report) { backend_report_test(); }
 #endif
 
 // ---------------------------------------------------------------------------
@@ -53,6 +54,13 @@ TEST(DataforgeTest, gost) { gost_test(); }
 TEST(DataforgeTest, streebog) { streebog_test(); }
 TEST(DataforgeTest, whirlpool) { whirlpool_test(); }
 TEST(DataforgeTest, blake) { blake_test(); }
+TEST(DataforgeTest, hmac) { hmac_test(); }
+TEST(DataforgeTest, midstate) { midstate_test(); }
+TEST(DataforgeTest, pbkdf2) { pbkdf2_test(); }
+TEST(DataforgeTest, hkdf) { hkdf_test(); }
+TEST(DataforgeTest, merkle) { merkle_test(); }
+TEST(DataforgeTest, fixed_digest) { fixed_digest_test(); }
+TEST(DataforgeTest, autotune) { autotune_test(); }
 
 TEST(DataforgeTest, rc2) { rc2_test(); }
 TEST(DataforgeTest, rc4) { rc4_test(); }
@@ -70,6 +78,21 @@ TEST(DataforgeTest, deflate) { deflate_test(); }
 TEST(DataforgeTest, bzip2) { bzip2_test(); }
 TEST(DataforgeTest, lzma) { lzma_test(); }
 TEST(DataforgeTest, lz4) { lz4_test(); }
+TEST(DataforgeTest, instrumentation) { instrumentation_test(); }
+TEST(DataforgeTest, stage_major) { stage_major_test(); }
+TEST(DataforgeTest, threaded) { threaded_test(); }
+TEST(DataforgeTest, parallel_convert) { parallel_convert_test(); }
+TEST(DataforgeTest, async_pull) { async_pull_test(); }
+TEST(DataforgeTest, mapped_file) { mapped_file_test(); }
+TEST(DataforgeTest, fd_sink) { fd_sink_test(); }
+TEST(DataforgeTest, uring_file) { uring_file_test(); }
+TEST(DataforgeTest, bulk_append) { bulk_append_test(); }
+TEST(DataforgeTest, chunked_provider) { chunked_provider_test(); }
+TEST(DataforgeTest, convert) { convert_test(); }
+TEST(DataforgeTest, bounded_push) { bounded_push_test(); }
+TEST(DataforgeTest, tee) { tee_test(); }
+TEST(DataforgeTest, batched_push) { batched_push_test(); }
+TEST(DataforgeTest, runtime_pipeline) { runtime_pipeline_test(); }
 
 #endif // DATAFORGE_TEST_FULL_SUITE
 